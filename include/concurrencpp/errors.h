@@ -39,6 +39,10 @@ namespace concurrencpp::errors {
     struct runtime_shutdown : public std::runtime_error {
         using runtime_error::runtime_error;
     };
+
+    struct queue_full : public std::runtime_error {
+        using runtime_error::runtime_error;
+    };
 }  // namespace concurrencpp::errors
 
 #endif  // ERRORS_H
@@ -0,0 +1,71 @@
+#ifndef CONCURRENCPP_BOUNDED_EXECUTOR_H
+#define CONCURRENCPP_BOUNDED_EXECUTOR_H
+
+#include "concurrencpp/results/lazy_result.h"
+#include "concurrencpp/executors/constants.h"
+#include "concurrencpp/executors/derivable_executor.h"
+
+#include <memory>
+
+namespace concurrencpp {
+    enum class queue_full_policy { throw_exception, drop_oldest, block };
+
+    /*
+        Bounds the number of tasks that wait to be executed by an underlying executor.
+        Tasks are kept in a queue of at most capacity tasks, and the underlying executor is given
+        one light-weight runner per queued task, which executes the oldest queued task.
+        When the queue is full, enqueue throws errors::queue_full, drops the oldest queued task
+        or blocks the calling thread, according to the policy. post_async suspends the calling coroutine instead.
+        If the underlying executor rejects a runner, the bounded executor shuts itself down and drops its queued tasks.
+    */
+    class bounded_executor final : public derivable_executor<bounded_executor> {
+
+       private:
+        struct bounded_state;
+
+        const std::shared_ptr<bounded_state> m_state;
+
+        lazy_result<void> post_async_impl(std::shared_ptr<executor> resume_executor, task task);
+
+       public:
+        bounded_executor(std::shared_ptr<executor> underlying_executor, size_t capacity, queue_full_policy policy);
+
+        void enqueue(concurrencpp::task task) override;
+        void enqueue(std::span<concurrencpp::task> tasks) override;
+
+        /*
+            Like post, but if the queue is full the calling coroutine is suspended until a queued task is taken for execution,
+            then resumed in resume_executor. Applies backpressure regardless of the policy.
+        */
+        template<class callable_type, class... argument_types>
+        lazy_result<void> post_async(std::shared_ptr<executor> resume_executor,
+                                     callable_type&& callable,
+                                     argument_types&&... arguments) {
+            static_assert(std::is_invocable_v<callable_type, argument_types...>,
+                          "concurrencpp::bounded_executor::post_async - "
+                          "<<callable_type>> is not invokable with <<argument_types...>>");
+
+            if (!static_cast<bool>(resume_executor)) {
+                throw std::invalid_argument(details::consts::k_bounded_executor_null_resume_executor_err_msg);
+            }
+
+            return post_async_impl(
+                std::move(resume_executor),
+                task(details::bind_with_try_catch(std::forward<callable_type>(callable), std::forward<argument_types>(arguments)...)));
+        }
+
+        int max_concurrency_level() const noexcept override;
+
+        bool shutdown_requested() const override;
+        void shutdown() override;
+
+        std::shared_ptr<executor> underlying_executor() const noexcept;
+        size_t capacity() const noexcept;
+        queue_full_policy policy() const noexcept;
+
+        size_t size() const;
+        size_t dropped_task_count() const noexcept;
+    };
+}  // namespace concurrencpp
+
+#endif
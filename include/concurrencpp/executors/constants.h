@@ -1,24 +1,83 @@
 #ifndef CONCURRENCPP_EXECUTORS_CONSTS_H
 #define CONCURRENCPP_EXECUTORS_CONSTS_H
 
+#include <chrono>
 #include <numeric>
 
+#include <cstddef>
+
 namespace concurrencpp::details::consts {
     inline const char* k_inline_executor_name = "concurrencpp::inline_executor";
     constexpr int k_inline_executor_max_concurrency_level = 0;
 
     inline const char* k_thread_executor_name = "concurrencpp::thread_executor";
     constexpr int k_thread_executor_max_concurrency_level = std::numeric_limits<int>::max();
+    constexpr size_t k_thread_executor_default_max_cached_threads = 0;
+    constexpr std::chrono::milliseconds k_thread_executor_default_max_cached_thread_idle_time {60 * 1'000};
 
     inline const char* k_thread_pool_executor_name = "concurrencpp::thread_pool_executor";
     inline const char* k_background_executor_name = "concurrencpp::background_executor";
+    constexpr size_t k_thread_pool_worker_initial_queue_capacity = 256;
+    constexpr size_t k_thread_pool_worker_initial_priority_queue_capacity = 32;
+    constexpr size_t k_thread_pool_priority_count = 3;
+    constexpr size_t k_thread_pool_default_priority_starvation_limit = 32;
+    constexpr bool k_thread_pool_default_next_task_slot = false;
+    constexpr size_t k_thread_pool_default_next_task_slot_limit = 16;
+    constexpr bool k_thread_pool_default_work_stealing = false;
+    constexpr std::chrono::microseconds k_thread_pool_default_idle_spin_time {0};
+    constexpr std::chrono::microseconds k_thread_pool_default_idle_yield_time {0};
+    constexpr bool k_thread_pool_default_adaptive_idle_spinning = false;
+    constexpr int k_thread_pool_adaptive_spin_factor = 2;
+    constexpr int k_thread_pool_idle_time_smoothing_factor = 8;
+    constexpr bool k_thread_pool_default_numa_aware = false;
+    constexpr bool k_thread_pool_default_prewarm_workers = false;
+    constexpr size_t k_thread_pool_default_min_alive_workers = 0;
+    constexpr size_t k_thread_pool_default_retirement_idle_periods = 1;
+    constexpr bool k_thread_pool_default_staggered_retirement = false;
+    constexpr size_t k_thread_pool_default_max_compensation_workers = 0;
+    constexpr std::chrono::milliseconds k_thread_pool_spawn_retry_delay {10};
+    inline const char* k_numa_node_executor_name = "concurrencpp::numa_node_executor_";
+    inline const char* k_thread_pool_executor_unknown_numa_node_err_msg =
+        "concurrencpp::thread_pool_executor::thread_pool_executor() - one of the given numa nodes doesn't exist.";
+    inline const char* k_thread_pool_executor_numa_affinity_mismatch_err_msg =
+        "concurrencpp::thread_pool_executor::thread_pool_executor() - the cpu affinity doesn't contain any cpu of the given numa nodes.";
+    inline const char* k_thread_pool_executor_invalid_priority_err_msg =
+        "concurrencpp::thread_pool_executor::enqueue() - the given priority is not a valid task_priority.";
 
     constexpr int k_worker_thread_max_concurrency_level = 1;
     inline const char* k_worker_thread_executor_name = "concurrencpp::worker_thread_executor";
+    constexpr bool k_worker_thread_default_busy_poll = false;
 
     inline const char* k_manual_executor_name = "concurrencpp::manual_executor";
     constexpr int k_manual_executor_max_concurrency_level = std::numeric_limits<int>::max();
 
+    inline const char* k_strand_executor_name = "concurrencpp::strand_executor";
+    constexpr int k_strand_executor_max_concurrency_level = 1;
+    constexpr size_t k_strand_executor_default_max_batch_size = 64;
+    inline const char* k_strand_executor_null_executor_err_msg =
+        "concurrencpp::strand_executor::strand_executor() - the underlying executor is null.";
+    inline const char* k_strand_executor_invalid_batch_size_err_msg =
+        "concurrencpp::strand_executor::strand_executor() - max_batch_size must be positive.";
+
+    inline const char* k_keyed_executor_name = "concurrencpp::keyed_executor";
+    inline const char* k_keyed_executor_null_executor_err_msg =
+        "concurrencpp::keyed_executor::keyed_executor() - the underlying executor is null.";
+    inline const char* k_keyed_executor_invalid_lane_count_err_msg =
+        "concurrencpp::keyed_executor::keyed_executor() - lane_count must be positive.";
+    inline const char* k_keyed_executor_invalid_lane_err_msg = "concurrencpp::keyed_executor - the given lane doesn't exist.";
+
+    inline const char* k_deadline_executor_invalid_pool_size_err_msg =
+        "concurrencpp::deadline_executor::deadline_executor() - pool_size must be positive.";
+
+    inline const char* k_bounded_executor_name = "concurrencpp::bounded_executor";
+    inline const char* k_bounded_executor_null_executor_err_msg =
+        "concurrencpp::bounded_executor::bounded_executor() - the underlying executor is null.";
+    inline const char* k_bounded_executor_invalid_capacity_err_msg =
+        "concurrencpp::bounded_executor::bounded_executor() - capacity must be positive.";
+    inline const char* k_bounded_executor_null_resume_executor_err_msg =
+        "concurrencpp::bounded_executor::post_async() - given resume executor is null.";
+    inline const char* k_bounded_executor_queue_full_err_msg = "concurrencpp::bounded_executor::enqueue() - the queue is full.";
+
     inline const char* k_executor_shutdown_err_msg = " - shutdown has been called on this executor.";
 }  // namespace concurrencpp::details::consts
 
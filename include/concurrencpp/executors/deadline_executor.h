@@ -0,0 +1,159 @@
+#ifndef CONCURRENCPP_DEADLINE_EXECUTOR_H
+#define CONCURRENCPP_DEADLINE_EXECUTOR_H
+
+#include "concurrencpp/threads/thread.h"
+#include "concurrencpp/threads/cache_line.h"
+#include "concurrencpp/executors/constants.h"
+#include "concurrencpp/executors/derivable_executor.h"
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <condition_variable>
+
+#include <cstdint>
+
+namespace concurrencpp {
+    enum class deadline_miss_policy { execute, drop };
+
+    /*
+        A thread pool that executes the earliest deadline first. Every worker keeps its tasks in a deadline ordered heap,
+        an idle worker steals the earliest task it can find from the other workers.
+        Tasks that are enqueued without a deadline are executed after all the tasks that have one, in FIFO order.
+        A task that starts after its deadline is counted as missed, and is destroyed without being executed
+        if it was enqueued with deadline_miss_policy::drop.
+    */
+    class deadline_executor final : public derivable_executor<deadline_executor> {
+
+       public:
+        // the clock timer_queue uses
+        using clock_type = std::chrono::high_resolution_clock;
+        using time_point = std::chrono::time_point<clock_type>;
+
+       private:
+        struct deadline_task {
+            time_point deadline;
+            std::uint64_t sequence;
+            deadline_miss_policy policy;
+            task callable;
+        };
+
+        struct worker {
+            std::mutex lock;
+            std::vector<deadline_task> heap;
+        };
+
+        struct deadline_enqueuer {
+            deadline_executor& executor;
+            const time_point deadline;
+            const deadline_miss_policy policy;
+
+            void enqueue(task task) {
+                executor.enqueue(std::move(task), deadline, policy);
+            }
+
+            void enqueue(std::span<task> tasks) {
+                executor.enqueue(tasks, deadline, policy);
+            }
+        };
+
+        std::vector<std::unique_ptr<worker>> m_workers;
+        std::vector<details::thread> m_threads;
+        std::atomic_uint64_t m_sequence;
+        std::atomic_size_t m_round_robin_cursor;
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic_intptr_t m_queued_count;
+        std::atomic_size_t m_idle_count;
+        std::mutex m_lock;
+        std::condition_variable m_condition;
+        std::atomic_bool m_abort;
+        std::atomic_size_t m_missed_deadline_count;
+        std::atomic_size_t m_dropped_task_count;
+        const executor_thread_options m_thread_options;
+
+        template<class source_clock_type, class duration_type>
+        static time_point to_deadline(std::chrono::time_point<source_clock_type, duration_type> deadline) {
+            if constexpr (std::is_same_v<source_clock_type, clock_type>) {
+                return std::chrono::time_point_cast<time_point::duration>(deadline);
+            } else {
+                using float_duration = std::chrono::duration<double, time_point::period>;
+
+                const auto source_now = source_clock_type::now();
+                const auto now = clock_type::now();
+
+                // deadlines that clock_type can't represent (like the common "no deadline" sentinel time_point::max()) are clamped.
+                // the check is done in floating point so it can't overflow itself, with a margin for its rounding.
+                const auto remaining =
+                    float_duration(deadline.time_since_epoch()) - float_duration(source_now.time_since_epoch());
+                const auto margin = float_duration(std::chrono::milliseconds(1));
+
+                if (remaining >= float_duration(time_point::max() - now) - margin) {
+                    return time_point::max();
+                }
+
+                const auto min_remaining =
+                    float_duration(time_point::min().time_since_epoch()) - float_duration(now.time_since_epoch());
+                if (remaining <= min_remaining + margin) {
+                    return time_point::min();
+                }
+
+                return now + std::chrono::duration_cast<time_point::duration>(deadline - source_now);
+            }
+        }
+
+        static bool executes_later(const deadline_task& a, const deadline_task& b) noexcept;
+
+        size_t target_worker() noexcept;
+        void push(size_t worker_index, std::span<task> tasks, time_point deadline, deadline_miss_policy policy);
+
+        bool pop(size_t worker_index, deadline_task& task);
+        bool steal(size_t worker_index, deadline_task& task);
+        bool wait_for_task();
+        void execute(deadline_task& task);
+
+        void work_loop(size_t worker_index);
+
+       public:
+        deadline_executor(std::string_view pool_name, size_t pool_size, const executor_thread_options& thread_options = {});
+
+        void enqueue(task task) override;
+        void enqueue(std::span<task> tasks) override;
+
+        void enqueue(task task, time_point deadline, deadline_miss_policy policy = deadline_miss_policy::execute);
+        void enqueue(std::span<task> tasks, time_point deadline, deadline_miss_policy policy = deadline_miss_policy::execute);
+
+        template<class source_clock_type, class duration_type, class callable_type, class... argument_types>
+        void post_with_deadline(std::chrono::time_point<source_clock_type, duration_type> deadline,
+                                deadline_miss_policy policy,
+                                callable_type&& callable,
+                                argument_types&&... arguments) {
+            deadline_enqueuer enqueuer {*this, to_deadline(deadline), policy};
+            return do_post(enqueuer, std::forward<callable_type>(callable), std::forward<argument_types>(arguments)...);
+        }
+
+        template<class source_clock_type, class duration_type, class callable_type, class... argument_types>
+        auto submit_with_deadline(std::chrono::time_point<source_clock_type, duration_type> deadline,
+                                  deadline_miss_policy policy,
+                                  callable_type&& callable,
+                                  argument_types&&... arguments) {
+            static_assert(std::is_invocable_v<callable_type, argument_types...>,
+                          "concurrencpp::deadline_executor::submit_with_deadline - "
+                          "<<callable_type>> is not invokable with <<argument_types...>>");
+
+            deadline_enqueuer enqueuer {*this, to_deadline(deadline), policy};
+            return do_submit(enqueuer, std::forward<callable_type>(callable), std::forward<argument_types>(arguments)...);
+        }
+
+        int max_concurrency_level() const noexcept override;
+
+        bool shutdown_requested() const override;
+        void shutdown() override;
+
+        // tasks that started after their deadline, including the dropped ones
+        size_t missed_deadline_count() const noexcept;
+        size_t dropped_task_count() const noexcept;
+    };
+}  // namespace concurrencpp
+
+#endif
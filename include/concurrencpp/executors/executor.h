@@ -12,17 +12,43 @@
 namespace concurrencpp::details {
     [[noreturn]] void throw_runtime_shutdown_exception(std::string_view executor_name);
     std::string make_executor_worker_name(std::string_view executor_name);
+
+    // runs a submitted callable and publishes its return value directly, without a bridging coroutine
+    template<class return_type, class callable_type>
+    class submit_functor {
+
+       private:
+        producer_result_state_ptr<return_type> m_state;
+        callable_type m_callable;
+
+       public:
+        template<class given_callable_type>
+        submit_functor(result_state<return_type>* state, given_callable_type&& callable) :
+            m_state(state), m_callable(std::forward<given_callable_type>(callable)) {}
+
+        submit_functor(submit_functor&&) = default;
+
+        ~submit_functor() noexcept {
+            if (!static_cast<bool>(m_state)) {
+                return;
+            }
+
+            // the task was destroyed without being executed
+            m_state->set_exception(std::make_exception_ptr(errors::broken_task(consts::k_broken_task_exception_error_msg)));
+            m_state.reset();
+        }
+
+        void operator()() noexcept {
+            m_state->from_callable(m_callable);
+            m_state.reset();
+        }
+    };
 }  // namespace concurrencpp::details
 
 namespace concurrencpp {
     class executor {
 
        private:
-        template<class return_type, class executor_type, class callable_type, class... argument_types>
-        static result<return_type> submit_bridge(executor_tag, executor_type&, callable_type callable, argument_types... arguments) {
-            co_return callable(arguments...);
-        }
-
         template<class callable_type, class return_type = typename std::invoke_result_t<callable_type>>
         static result<return_type> bulk_submit_bridge(details::executor_bulk_tag,
                                                       std::vector<concurrencpp::task>& accumulator,
@@ -46,10 +72,17 @@ namespace concurrencpp {
                           "concurrencpp::executor::submit - <<callable_type>> is not invokable with <<argument_types...>>");
 
             using return_type = typename std::invoke_result_t<callable_type, argument_types...>;
-            return submit_bridge<return_type>({},
-                                              executor_ref,
-                                              std::forward<callable_type>(callable),
-                                              std::forward<argument_types>(arguments)...);
+            using bound_callable_type = std::decay_t<decltype(
+                details::bind(std::forward<callable_type>(callable), std::forward<argument_types>(arguments)...))>;
+
+            const auto state = new details::result_state<return_type>();
+            result<return_type> submit_result(state);
+
+            executor_ref.enqueue(details::submit_functor<return_type, bound_callable_type>(
+                state,
+                details::bind(std::forward<callable_type>(callable), std::forward<argument_types>(arguments)...)));
+
+            return submit_result;
         }
 
         template<class executor_type, class callable_type>
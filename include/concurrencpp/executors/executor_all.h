@@ -7,5 +7,9 @@
 #include "concurrencpp/executors/thread_executor.h"
 #include "concurrencpp/executors/worker_thread_executor.h"
 #include "concurrencpp/executors/manual_executor.h"
+#include "concurrencpp/executors/strand_executor.h"
+#include "concurrencpp/executors/keyed_executor.h"
+#include "concurrencpp/executors/deadline_executor.h"
+#include "concurrencpp/executors/bounded_executor.h"
 
 #endif
@@ -0,0 +1,65 @@
+#ifndef CONCURRENCPP_MPSC_TASK_QUEUE_H
+#define CONCURRENCPP_MPSC_TASK_QUEUE_H
+
+#include "concurrencpp/task.h"
+#include "concurrencpp/threads/cache_line.h"
+
+#include <span>
+#include <deque>
+#include <atomic>
+#include <vector>
+
+namespace concurrencpp::details {
+    enum class mpsc_push_status { closed, first, appended };
+
+    /*
+        A multi-producer/single-consumer task queue. Producers push a node with a single CAS,
+        the consumer detaches all pushed nodes at once and restores their FIFO order.
+        Once closed, pushes fail and the remaining tasks are destroyed.
+        Every push can be tagged with a lane, pop_all can sort the tasks into one destination per lane.
+        Nodes come from the task_allocator pool, a node freed by the consumer goes back to the producer that pushed it.
+        The link can't be intrusive: a pushed task is moved out of the producer's storage, so it needs storage of its own.
+        As long as the consumer keeps up, that storage is recycled by the pool and pushes don't reach the global allocator.
+    */
+    class alignas(CRCPP_CACHE_LINE_ALIGNMENT) mpsc_task_queue {
+
+       private:
+        struct node {
+            node* next = nullptr;
+            size_t lane = 0;
+            task single_task;
+            std::vector<task> tasks;
+
+            static void* operator new(size_t size);
+            static void operator delete(void* pointer, size_t size) noexcept;
+        };
+
+        std::atomic<node*> m_head;
+        std::atomic<node*> m_backlog;  // consumer-only, FIFO ordered nodes a throwing pop_all couldn't hand over
+
+        node* closed_tag() const noexcept;
+        mpsc_push_status push_node(node* new_node) noexcept;
+
+        static void destroy_list(node* head) noexcept;
+        static node* pop_node_tasks(node* current, std::span<std::deque<task>> destinations, size_t& count);
+
+       public:
+        mpsc_task_queue() noexcept;
+        ~mpsc_task_queue() noexcept;
+
+        mpsc_task_queue(const mpsc_task_queue&) = delete;
+        mpsc_task_queue& operator=(const mpsc_task_queue&) = delete;
+
+        mpsc_push_status push(task& task, size_t lane = 0);
+        mpsc_push_status push(std::span<task> tasks, size_t lane = 0);
+
+        size_t pop_all(std::deque<task>& destination);
+        size_t pop_all(std::span<std::deque<task>> destinations);
+
+        bool empty() const noexcept;
+
+        void close() noexcept;
+    };
+}  // namespace concurrencpp::details
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef CONCURRENCPP_WORK_STEALING_DEQUE_H
+#define CONCURRENCPP_WORK_STEALING_DEQUE_H
+
+#include "concurrencpp/task.h"
+#include "concurrencpp/threads/cache_line.h"
+
+#include <span>
+#include <atomic>
+#include <memory>
+
+#include <cstdint>
+
+namespace concurrencpp::details {
+    /*
+        A Chase-Lev deque: the owner pushes and pops tasks at the bottom without locking,
+        thieves take the oldest tasks from the top. Thieves are serialized by m_steal_lock
+        so a slot is never overwritten while a thief is still moving a task out of it.
+        The owner only takes m_steal_lock when it races a thief over the last task or when it grows the buffer.
+    */
+    class work_stealing_deque {
+
+       private:
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic<std::int64_t> m_top;
+        std::atomic_bool m_steal_lock;
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic<std::int64_t> m_bottom;
+        std::unique_ptr<task[]> m_slots;
+        std::int64_t m_mask;
+
+        task& slot_at(std::int64_t index) noexcept;
+
+        bool try_lock_steal() noexcept;
+        void lock_steal() noexcept;
+        void unlock_steal() noexcept;
+
+        void reallocate(std::int64_t new_capacity);
+        void grow(std::int64_t top, std::int64_t required_bottom);
+
+       public:
+        work_stealing_deque(size_t initial_capacity);
+
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+        // owner only
+        void push(task& task);
+        void push(std::span<task> tasks);
+        bool pop(task& task) noexcept;
+
+        // re-allocates the buffer from the calling thread, so first-touch places it on the caller's memory node
+        void relocate();
+
+        // any thread
+        bool steal(task& task) noexcept;
+
+        size_t size() const noexcept;
+        bool empty() const noexcept;
+
+        // no concurrent access is allowed
+        void clear() noexcept;
+    };
+}  // namespace concurrencpp::details
+
+#endif
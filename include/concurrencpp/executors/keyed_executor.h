@@ -0,0 +1,78 @@
+#ifndef CONCURRENCPP_KEYED_EXECUTOR_H
+#define CONCURRENCPP_KEYED_EXECUTOR_H
+
+#include "concurrencpp/executors/constants.h"
+#include "concurrencpp/executors/strand_executor.h"
+#include "concurrencpp/executors/derivable_executor.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <functional>
+
+namespace concurrencpp {
+    /*
+        Executes tasks that share a key serially and in FIFO order, and tasks of different keys in parallel.
+        Keys are hashed onto a fixed set of serial lanes (strand_executors) that are multiplexed over one underlying executor.
+        Tasks that are enqueued without a key are spread over the lanes in a round-robin fashion.
+    */
+    class keyed_executor final : public derivable_executor<keyed_executor> {
+
+       private:
+        std::vector<std::shared_ptr<strand_executor>> m_lanes;
+        std::atomic_size_t m_round_robin_cursor;
+        std::atomic_bool m_abort;
+        const std::shared_ptr<executor> m_underlying_executor;
+
+        static size_t mix_hash(size_t hash) noexcept;
+
+       public:
+        keyed_executor(std::shared_ptr<executor> underlying_executor,
+                       size_t lane_count,
+                       size_t max_batch_size = details::consts::k_strand_executor_default_max_batch_size);
+
+        void enqueue(concurrencpp::task task) override;
+        void enqueue(std::span<concurrencpp::task> tasks) override;
+
+        int max_concurrency_level() const noexcept override;
+
+        bool shutdown_requested() const override;
+        void shutdown() override;
+
+        template<class key_type>
+        size_t lane_of(const key_type& key) const noexcept(noexcept(std::hash<key_type> {}(key))) {
+            return mix_hash(std::hash<key_type> {}(key)) % m_lanes.size();
+        }
+
+        template<class key_type, class callable_type, class... argument_types>
+        void post(const key_type& key, callable_type&& callable, argument_types&&... arguments) {
+            m_lanes[lane_of(key)]->post(std::forward<callable_type>(callable), std::forward<argument_types>(arguments)...);
+        }
+
+        template<class key_type, class callable_type, class... argument_types>
+        auto submit(const key_type& key, callable_type&& callable, argument_types&&... arguments) {
+            return m_lanes[lane_of(key)]->submit(std::forward<callable_type>(callable), std::forward<argument_types>(arguments)...);
+        }
+
+        template<class key_type, class callable_type>
+        void bulk_post(const key_type& key, std::span<callable_type> callable_list) {
+            m_lanes[lane_of(key)]->bulk_post(callable_list);
+        }
+
+        template<class key_type, class callable_type, class return_type = std::invoke_result_t<callable_type>>
+        std::vector<concurrencpp::result<return_type>> bulk_submit(const key_type& key, std::span<callable_type> callable_list) {
+            return m_lanes[lane_of(key)]->template bulk_submit<callable_type, return_type>(callable_list);
+        }
+
+        size_t lane_count() const noexcept;
+        std::shared_ptr<strand_executor> lane(size_t index) const;
+
+        std::shared_ptr<executor> underlying_executor() const noexcept;
+
+        // queue depth metrics, approximate as the lanes are concurrently executed
+        size_t queue_depth(size_t lane_index) const;
+        std::vector<size_t> queue_depths() const;
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -16,6 +16,8 @@ namespace concurrencpp {
         std::condition_variable m_condition;
         bool m_abort;
         std::atomic_bool m_atomic_abort;
+        int m_wakeup_fd;
+        bool m_wakeup_signaled;
 
         template<class clock_type, class duration_type>
         static std::chrono::system_clock::time_point to_system_time_point(
@@ -29,6 +31,13 @@ namespace concurrencpp {
             return std::chrono::system_clock::now() + ms;
         }
 
+        void signal_wakeup_fd() noexcept;
+        void reset_wakeup_fd() noexcept;
+
+        void take_batch(std::deque<task>& batch, size_t max_count);
+        void requeue_batch(std::deque<task>& batch);
+        size_t execute_batch(std::deque<task>& batch);
+
         size_t loop_impl(size_t max_count);
         size_t loop_until_impl(size_t max_count, std::chrono::time_point<std::chrono::system_clock> deadline);
 
@@ -37,6 +46,7 @@ namespace concurrencpp {
 
        public:
         manual_executor();
+        ~manual_executor() noexcept;
 
         void enqueue(task task) override;
         void enqueue(std::span<task> tasks) override;
@@ -51,6 +61,19 @@ namespace concurrencpp {
 
         size_t clear();
 
+        /*
+            Takes all the queued tasks under a single lock and executes them outside of it.
+            Returns the number of executed tasks.
+        */
+        size_t drain();
+
+        /*
+            Returns a non-blocking file descriptor that is readable while this executor has queued tasks,
+            so the executor can be driven from an epoll/poll loop. Only the empty to non-empty transition writes to it,
+            the executor resets it once its queue is emptied. Returns -1 on platforms other than Linux.
+        */
+        int wakeup_fd();
+
         bool loop_once();
         bool loop_once_for(std::chrono::milliseconds max_waiting_time);
 
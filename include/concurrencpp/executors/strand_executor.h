@@ -0,0 +1,42 @@
+#ifndef CONCURRENCPP_STRAND_EXECUTOR_H
+#define CONCURRENCPP_STRAND_EXECUTOR_H
+
+#include "concurrencpp/executors/constants.h"
+#include "concurrencpp/executors/derivable_executor.h"
+
+#include <memory>
+
+namespace concurrencpp {
+    /*
+        Executes its tasks one at a time and in FIFO order on top of an underlying executor.
+        Tasks are pushed to a lock-free queue, the strand enqueues itself to the underlying executor
+        only when it goes from empty to non-empty, and executes at most max_batch_size tasks every time it is scheduled.
+    */
+    class strand_executor final : public derivable_executor<strand_executor> {
+
+       private:
+        struct strand_state;
+
+        const std::shared_ptr<strand_state> m_state;
+
+       public:
+        strand_executor(std::shared_ptr<executor> underlying_executor,
+                        size_t max_batch_size = details::consts::k_strand_executor_default_max_batch_size);
+
+        void enqueue(concurrencpp::task task) override;
+        void enqueue(std::span<concurrencpp::task> tasks) override;
+
+        int max_concurrency_level() const noexcept override;
+
+        bool shutdown_requested() const override;
+        void shutdown() override;
+
+        std::shared_ptr<executor> underlying_executor() const noexcept;
+        size_t max_batch_size() const noexcept;
+
+        // approximate: tasks of the batch that is being executed are counted until the whole batch is done
+        size_t size() const noexcept;
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -3,29 +3,49 @@
 
 #include "concurrencpp/threads/thread.h"
 #include "concurrencpp/threads/cache_line.h"
+#include "concurrencpp/executors/constants.h"
 #include "concurrencpp/executors/derivable_executor.h"
 
 #include <list>
 #include <span>
 #include <mutex>
+#include <vector>
+#include <chrono>
 #include <condition_variable>
 
 namespace concurrencpp {
     class alignas(CRCPP_CACHE_LINE_ALIGNMENT) thread_executor final : public derivable_executor<thread_executor> {
 
        private:
+        struct worker {
+            details::thread thread;
+            task next_task;  // handed over by enqueue while the thread is parked
+            std::condition_variable condition;
+        };
+
+        using worker_iterator = std::list<worker>::iterator;
+
         std::mutex m_lock;
-        std::list<details::thread> m_workers;
+        std::list<worker> m_workers;
+        std::vector<worker_iterator> m_parked_workers;
         std::condition_variable m_condition;
-        std::list<details::thread> m_last_retired;
+        std::list<worker> m_last_retired;
         bool m_abort;
         std::atomic_bool m_atomic_abort;
+        const executor_thread_options m_thread_options;
+        const size_t m_max_cached_threads;
+        const std::chrono::milliseconds m_max_cached_thread_idle_time;
 
         void enqueue_impl(std::unique_lock<std::mutex>& lock, task& task);
-        void retire_worker(std::list<details::thread>::iterator it);
+        void work_loop(worker_iterator self_it, task& task);
+        bool wait_for_task(worker_iterator self_it, task& task);
+        void retire_worker(worker_iterator it);
 
        public:
-        thread_executor();
+        thread_executor(const executor_thread_options& thread_options = {},
+                        size_t max_cached_threads = details::consts::k_thread_executor_default_max_cached_threads,
+                        std::chrono::milliseconds max_cached_thread_idle_time =
+                            details::consts::k_thread_executor_default_max_cached_thread_idle_time);
         ~thread_executor() noexcept;
 
         void enqueue(task task) override;
@@ -35,6 +55,9 @@ namespace concurrencpp {
 
         bool shutdown_requested() const override;
         void shutdown() override;
+
+        size_t max_cached_threads() const noexcept;
+        std::chrono::milliseconds max_cached_thread_idle_time() const noexcept;
     };
 }  // namespace concurrencpp
 
@@ -2,121 +2,348 @@
 #define CONCURRENCPP_THREAD_POOL_EXECUTOR_H
 
 #include "concurrencpp/threads/thread.h"
+#include "concurrencpp/executors/constants.h"
 #include "concurrencpp/threads/cache_line.h"
 #include "concurrencpp/threads/binary_semaphore.h"
 #include "concurrencpp/executors/derivable_executor.h"
+#include "concurrencpp/executors/impl/mpsc_task_queue.h"
+#include "concurrencpp/executors/impl/work_stealing_deque.h"
+#include "concurrencpp/executors/thread_pool_executor_options.h"
 
+#include <array>
 #include <deque>
 #include <mutex>
+#include <condition_variable>
+
+#include <cstdint>
 
 namespace concurrencpp::details {
+    /*
+        A two-level atomic bitmap of idle workers. Every word of m_idle_words holds the idle bits of 64 workers,
+        every bit of m_summary_words hints that the matching idle word might have a set bit,
+        so idle workers are found with a few count-trailing-zeros instructions instead of a linear scan.
+    */
     class idle_worker_set {
 
-        enum class status { active, idle };
-
-        struct alignas(CRCPP_CACHE_LINE_ALIGNMENT) padded_flag {
-            std::atomic<status> flag {status::active};
+        struct alignas(CRCPP_CACHE_LINE_ALIGNMENT) padded_word {
+            std::atomic<std::uint64_t> bits {0};
         };
 
        private:
         std::atomic_intptr_t m_approx_size;
-        const std::unique_ptr<padded_flag[]> m_idle_flags;
         const size_t m_size;
+        const size_t m_word_count;
+        const std::unique_ptr<padded_word[]> m_idle_words;
+        const std::unique_ptr<padded_word[]> m_summary_words;
+
+        void set_summary_bit(size_t word_index) noexcept;
+        void clear_summary_bit(size_t word_index) noexcept;
 
-        bool try_acquire_flag(size_t index) noexcept;
+        std::uint64_t acquire_bits(size_t word_index, std::uint64_t mask, size_t max_count) noexcept;
+
+        template<class visitor_type>
+        void visit_idle_words(size_t range_begin,
+                              size_t range_end,
+                              size_t starting_pos,
+                              size_t caller_index,
+                              visitor_type&& visitor) noexcept;
 
        public:
         idle_worker_set(size_t size);
 
+        size_t approx_size() const noexcept;
+
         void set_idle(size_t idle_thread) noexcept;
         void set_active(size_t idle_thread) noexcept;
 
         size_t find_idle_worker(size_t caller_index) noexcept;
         void find_idle_workers(size_t caller_index, std::vector<size_t>& result_buffer, size_t max_count) noexcept;
+
+        // only look for idle workers in [range_begin, range_end)
+        size_t find_idle_worker(size_t caller_index, size_t range_begin, size_t range_end) noexcept;
+        void find_idle_workers(size_t caller_index,
+                               std::vector<size_t>& result_buffer,
+                               size_t max_count,
+                               size_t range_begin,
+                               size_t range_end) noexcept;
     };
 }  // namespace concurrencpp::details
 
 namespace concurrencpp::details {
+    // the workers in [begin, end) belong to the NUMA node <<node_id>> and only run on its cpus
+    struct thread_pool_numa_partition {
+        size_t node_id;
+        size_t begin;
+        size_t end;
+        std::vector<size_t> cpus;
+    };
+
     class alignas(CRCPP_CACHE_LINE_ALIGNMENT) thread_pool_worker {
 
+        constexpr static size_t k_lane_count = consts::k_thread_pool_priority_count;
+        constexpr static size_t k_next_task_lane = 1;  // the next-task slot only holds task_priority::normal tasks
+
        private:
-        std::deque<task> m_private_queue;
+        // one lane per task_priority, lane 0 is the most urgent one
+        std::array<work_stealing_deque, k_lane_count> m_private_queues;
+        std::array<size_t, k_lane_count> m_starvation_counts;
+        task m_next_task;
+        size_t m_next_task_streak;
         std::vector<size_t> m_idle_worker_list;
+        std::array<std::vector<task>, k_lane_count> m_donation_buffers;
+        std::array<std::deque<task>, k_lane_count> m_public_batches;
+        bool m_searching;
+        bool m_queue_relocated;
+        std::chrono::nanoseconds m_idle_time_estimate;
+        const thread_pool_numa_partition* const m_numa_partition;
         std::atomic_bool m_atomic_abort;
         thread_pool_executor& m_parent_pool;
         const size_t m_index;
         const size_t m_pool_size;
         const std::chrono::milliseconds m_max_idle_time;
+        const bool m_keep_alive;
+        const bool m_compensation_slot;
+        std::atomic_bool m_compensating;
+        std::atomic_bool m_blocked;
         const std::string m_worker_name;
+        mpsc_task_queue m_public_queue;
+        std::atomic_intptr_t m_public_task_count;  // might go negative for a moment, the worker can pop before we count
         alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::mutex m_lock;
-        std::deque<task> m_public_queue;
         binary_semaphore m_semaphore;
         bool m_idle;
         bool m_abort;
+        bool m_steal_requested;
         std::atomic_bool m_task_found_or_abort;
         thread m_thread;
 
         void balance_work();
+        void donate_work();
+        bool steal_task(concurrencpp::task& task);
+
+        size_t private_task_count() const noexcept;
+        void on_lane_served(size_t lane) noexcept;
+        bool pop_from_lane(size_t lane, concurrencpp::task& task) noexcept;
+        bool pop_next_task(concurrencpp::task& task) noexcept;
+        bool pop_task(concurrencpp::task& task) noexcept;
+        bool steal_from_lanes(concurrencpp::task& task, size_t& lane) noexcept;
+
+        bool has_pending_event() const noexcept;
+        std::chrono::nanoseconds idle_spin_budget() const noexcept;
+        void record_idle_time(std::chrono::nanoseconds idle_time) noexcept;
+        bool spin_for_event() const noexcept;
 
         bool wait_for_task(std::unique_lock<std::mutex>& lock);
         bool drain_queue_impl();
         bool drain_queue();
 
+        void bind_to_numa_node();
         void work_loop();
 
         void ensure_worker_active(bool first_enqueuer, std::unique_lock<std::mutex>& lock);
+        void on_foreign_push(mpsc_push_status status, size_t task_count);
 
        public:
-        thread_pool_worker(thread_pool_executor& parent_pool, size_t index, size_t pool_size, std::chrono::milliseconds max_idle_time);
+        thread_pool_worker(thread_pool_executor& parent_pool,
+                           size_t index,
+                           size_t pool_size,
+                           std::chrono::milliseconds max_idle_time,
+                           const thread_pool_numa_partition* numa_partition,
+                           bool compensation_slot);
 
         thread_pool_worker(thread_pool_worker&& rhs) noexcept;
         ~thread_pool_worker() noexcept;
 
-        void enqueue_foreign(concurrencpp::task& task);
-        void enqueue_foreign(std::span<concurrencpp::task> tasks);
-        void enqueue_foreign(std::deque<concurrencpp::task>::iterator begin, std::deque<concurrencpp::task>::iterator end);
-        void enqueue_foreign(std::span<concurrencpp::task>::iterator begin, std::span<concurrencpp::task>::iterator end);
+        void enqueue_foreign(concurrencpp::task& task, size_t lane);
+        void enqueue_foreign(std::span<concurrencpp::task> tasks, size_t lane);
+        void enqueue_foreign(std::span<concurrencpp::task>::iterator begin, std::span<concurrencpp::task>::iterator end, size_t lane);
 
-        void enqueue_local(concurrencpp::task& task);
-        void enqueue_local(std::span<concurrencpp::task> tasks);
+        void enqueue_local(concurrencpp::task& task, size_t lane);
+        void enqueue_local(std::span<concurrencpp::task> tasks, size_t lane);
+
+        // puts <<task>> in the next-task slot, <<task>> is left with the task it displaced (if any)
+        void swap_next_task(concurrencpp::task& task);
+
+        void prewarm();
+        bool start_thread();
+
+        void request_steal();
+        bool try_steal(concurrencpp::task& task) noexcept;
 
         void shutdown();
+        void clear_tasks() noexcept;
+
+        // owner only, moves every queued task to <<substitute>> so none of them waits for us to unblock
+        size_t hand_over_tasks(thread_pool_worker& substitute);
+
+        size_t begin_blocking();
+        void end_blocking(size_t compensation_slot) noexcept;
+
+        bool blocked() const noexcept;
+
+        // a compensation slot no blocking region needs, it retires as soon as it runs out of tasks
+        bool dormant() const noexcept;
+
+        bool activate_compensation() noexcept;
+        void deactivate_compensation() noexcept;
 
         std::chrono::milliseconds max_worker_idle_time() const noexcept;
 
         bool appears_empty() const noexcept;
+
+        // how many tasks are queued, both private and foreign. can be called from any thread
+        size_t approx_load() const noexcept;
     };
 }  // namespace concurrencpp::details
 
 namespace concurrencpp {
+    // tasks of a higher priority are executed first, lower priorities are protected from starvation
+    enum class task_priority { high, normal, low };
+
     class alignas(CRCPP_CACHE_LINE_ALIGNMENT) thread_pool_executor final : public derivable_executor<thread_pool_executor> {
 
         friend class details::thread_pool_worker;
 
        private:
-        std::vector<details::thread_pool_worker> m_workers;
+        const size_t m_pool_size;
+        std::vector<details::thread_pool_worker> m_workers;  // [m_pool_size, m_workers.size()) are compensation slots
         alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic_size_t m_round_robin_cursor;
         alignas(CRCPP_CACHE_LINE_ALIGNMENT) details::idle_worker_set m_idle_workers;
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic_size_t m_searching_worker_count;
         alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic_bool m_abort;
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::mutex m_spawner_lock;
+        std::condition_variable m_spawner_condition;
+        std::vector<size_t> m_spawn_requests;
+        std::vector<size_t> m_failed_spawns;  // only touched by the spawner
+        bool m_spawner_abort;
+        details::thread m_spawner;
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic_size_t m_spawned_thread_count;
+        std::atomic_size_t m_retired_thread_count;
+        std::atomic_size_t m_blocked_worker_count;
+        std::atomic_size_t m_compensating_worker_count;
+        std::atomic<std::chrono::steady_clock::rep> m_last_retirement_time;
+        const thread_pool_executor_options m_options;
+        const std::vector<details::thread_pool_numa_partition> m_numa_partitions;
 
         void mark_worker_idle(size_t index) noexcept;
         void mark_worker_active(size_t index) noexcept;
+        size_t find_idle_worker(size_t caller_index) noexcept;
         void find_idle_workers(size_t caller_index, std::vector<size_t>& buffer, size_t max_count) noexcept;
 
+        const details::thread_pool_numa_partition* partition_of_worker(size_t index) const noexcept;
+        const details::thread_pool_numa_partition* partition_of_current_node() const noexcept;
+
         details::thread_pool_worker& worker_at(size_t index) noexcept;
 
+        void begin_searching() noexcept;
+        void end_searching() noexcept;
+        void wake_thief(size_t caller_index);
+        bool steal_task(size_t thief_index, task& task) noexcept;
+
+        void enqueue_external(std::span<task> tasks, size_t lane);
+        details::thread_pool_worker& round_robin_worker(size_t range_begin, size_t range_end) noexcept;
+
+        size_t begin_blocking(details::thread_pool_worker& blocked_worker);
+        void end_blocking(size_t compensation_slot) noexcept;
+
+        void request_worker_spawn(size_t index);
+        void spawner_loop();
+
+        bool try_retire_worker(std::chrono::steady_clock::time_point now) noexcept;
+
+        struct prioritized_enqueuer {
+            thread_pool_executor& executor;
+            const task_priority priority;
+
+            void enqueue(task task) {
+                executor.enqueue(std::move(task), priority);
+            }
+
+            void enqueue(std::span<task> tasks) {
+                executor.enqueue(tasks, priority);
+            }
+        };
+
        public:
-        thread_pool_executor(std::string_view pool_name, size_t pool_size, std::chrono::milliseconds max_idle_time);
+        thread_pool_executor(std::string_view pool_name,
+                             size_t pool_size,
+                             std::chrono::milliseconds max_idle_time,
+                             const thread_pool_executor_options& options = {});
 
         void enqueue(task task) override;
         void enqueue(std::span<task> tasks) override;
 
+        void enqueue(task task, task_priority priority);
+        void enqueue(std::span<task> tasks, task_priority priority);
+
+        using derivable_executor<thread_pool_executor>::post;
+        using derivable_executor<thread_pool_executor>::submit;
+        using derivable_executor<thread_pool_executor>::bulk_post;
+        using derivable_executor<thread_pool_executor>::bulk_submit;
+
+        template<class callable_type, class... argument_types>
+        void post(task_priority priority, callable_type&& callable, argument_types&&... arguments) {
+            prioritized_enqueuer enqueuer {*this, priority};
+            return do_post(enqueuer, std::forward<callable_type>(callable), std::forward<argument_types>(arguments)...);
+        }
+
+        template<class callable_type, class... argument_types>
+        auto submit(task_priority priority, callable_type&& callable, argument_types&&... arguments) {
+            static_assert(std::is_invocable_v<callable_type, argument_types...>,
+                          "concurrencpp::thread_pool_executor::submit - "
+                          "<<callable_type>> is not invokable with <<argument_types...>>");
+
+            prioritized_enqueuer enqueuer {*this, priority};
+            return do_submit(enqueuer, std::forward<callable_type>(callable), std::forward<argument_types>(arguments)...);
+        }
+
+        template<class callable_type>
+        void bulk_post(task_priority priority, std::span<callable_type> callable_list) {
+            prioritized_enqueuer enqueuer {*this, priority};
+            return do_bulk_post(enqueuer, callable_list);
+        }
+
+        template<class callable_type, class return_type = std::invoke_result_t<callable_type>>
+        std::vector<concurrencpp::result<return_type>> bulk_submit(task_priority priority, std::span<callable_type> callable_list) {
+            prioritized_enqueuer enqueuer {*this, priority};
+            return do_bulk_submit(enqueuer, callable_list);
+        }
+
         int max_concurrency_level() const noexcept override;
 
         bool shutdown_requested() const override;
         void shutdown() override;
 
         std::chrono::milliseconds max_worker_idle_time() const noexcept;
+        const thread_pool_executor_options& options() const noexcept;
+
+        size_t spawned_thread_count() const noexcept;
+        size_t retired_thread_count() const noexcept;
+
+        size_t blocked_worker_count() const noexcept;
+        size_t compensating_worker_count() const noexcept;
+    };
+
+    /*
+        Tells the thread_pool_executor the calling worker is about to block (on I/O, a lock, a result::get...).
+        Up to <<max_compensation_workers>> compensation workers take over the queued tasks of blocked workers
+        and the tasks that would have been enqueued to them, until the region ends.
+        Constructing a blocking_region outside of a thread_pool_executor worker has no effect.
+    */
+    class blocking_region {
+
+       private:
+        details::thread_pool_worker* const m_worker;
+        const size_t m_compensation_slot;
+
+       public:
+        blocking_region();
+        ~blocking_region() noexcept;
+
+        blocking_region(const blocking_region&) = delete;
+        blocking_region& operator=(const blocking_region&) = delete;
+
+        // whether a compensation worker runs in our place
+        bool compensated() const noexcept;
     };
 }  // namespace concurrencpp
 
@@ -0,0 +1,43 @@
+#ifndef CONCURRENCPP_THREAD_POOL_EXECUTOR_OPTIONS_H
+#define CONCURRENCPP_THREAD_POOL_EXECUTOR_OPTIONS_H
+
+#include "concurrencpp/threads/thread_options.h"
+
+#include <chrono>
+#include <vector>
+
+#include <cstddef>
+
+namespace concurrencpp {
+    struct thread_pool_executor_options {
+        bool work_stealing;
+
+        std::chrono::microseconds idle_spin_time;
+        std::chrono::microseconds idle_yield_time;
+        bool adaptive_idle_spinning;
+
+        bool prewarm_workers;
+        size_t min_alive_workers;
+        size_t retirement_idle_periods;
+        bool staggered_retirement;
+
+        size_t priority_starvation_limit;
+
+        bool next_task_slot;
+        size_t next_task_slot_limit;
+
+        size_t max_compensation_workers;
+
+        bool numa_aware;
+        std::vector<size_t> numa_nodes;
+
+        executor_thread_options thread_options;
+
+        thread_pool_executor_options() noexcept;
+
+        thread_pool_executor_options(const thread_pool_executor_options&) = default;
+        thread_pool_executor_options& operator=(const thread_pool_executor_options&) = default;
+    };
+}  // namespace concurrencpp
+
+#endif
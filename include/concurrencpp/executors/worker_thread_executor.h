@@ -4,10 +4,11 @@
 #include "concurrencpp/threads/thread.h"
 #include "concurrencpp/threads/cache_line.h"
 #include "concurrencpp/threads/binary_semaphore.h"
+#include "concurrencpp/executors/constants.h"
 #include "concurrencpp/executors/derivable_executor.h"
+#include "concurrencpp/executors/impl/mpsc_task_queue.h"
 
 #include <deque>
-#include <mutex>
 
 namespace concurrencpp {
     class alignas(CRCPP_CACHE_LINE_ALIGNMENT) worker_thread_executor final : public derivable_executor<worker_thread_executor> {
@@ -16,15 +17,15 @@ namespace concurrencpp {
         std::deque<task> m_private_queue;
         std::atomic_bool m_private_atomic_abort;
         details::thread m_thread;
-        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::mutex m_lock;
-        std::deque<task> m_public_queue;
+        details::mpsc_task_queue m_public_queue;
         details::binary_semaphore m_semaphore;
         std::atomic_bool m_atomic_abort;
-        bool m_abort;
+        const executor_thread_options m_thread_options;
+        const bool m_busy_poll;
 
         bool drain_queue_impl();
         bool drain_queue();
-        void wait_for_task(std::unique_lock<std::mutex>& lock);
+        void wait_for_task();
         void work_loop();
 
         void enqueue_local(concurrencpp::task& task);
@@ -34,7 +35,12 @@ namespace concurrencpp {
         void enqueue_foreign(std::span<concurrencpp::task> task);
 
        public:
-        worker_thread_executor();
+        /*
+            In busy-poll mode the worker spins on its queue instead of sleeping when it runs out of tasks:
+            enqueuing never makes a system call and tasks are picked up within microseconds, at the cost of a fully used core.
+        */
+        worker_thread_executor(const executor_thread_options& thread_options = {},
+                               bool busy_poll = details::consts::k_worker_thread_default_busy_poll);
 
         void enqueue(concurrencpp::task task) override;
         void enqueue(std::span<concurrencpp::task> tasks) override;
@@ -43,6 +49,8 @@ namespace concurrencpp {
 
         bool shutdown_requested() const override;
         void shutdown() override;
+
+        bool busy_polling() const noexcept;
     };
 }  // namespace concurrencpp
 
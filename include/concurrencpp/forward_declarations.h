@@ -27,6 +27,10 @@ namespace concurrencpp {
     class thread_executor;
     class worker_thread_executor;
     class manual_executor;
+    class strand_executor;
+    class keyed_executor;
+    class deadline_executor;
+    class bounded_executor;
 
     template<typename type>
     class generator;
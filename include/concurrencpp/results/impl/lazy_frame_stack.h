@@ -0,0 +1,37 @@
+#ifndef CONCURRENCPP_LAZY_FRAME_STACK_H
+#define CONCURRENCPP_LAZY_FRAME_STACK_H
+
+#include "concurrencpp/task_allocator.h"
+
+#include <cstddef>
+
+namespace concurrencpp::details {
+    /*
+        Allocates lazy_result coroutine frames by bumping a pointer inside per-thread segments.
+        Recursive lazy coroutines create and destroy their frames in LIFO order on the same thread, so the frame on top
+        of the stack gives its memory back right away. Frames that are freed out of order or by another thread only
+        release their segment, which is reused once all of its frames are gone.
+    */
+    class lazy_frame_stack {
+
+       public:
+        static void* allocate(size_t size);
+        static void deallocate(void* pointer, size_t size) noexcept;
+    };
+
+#ifdef CRCPP_LAZY_FRAME_STACK
+    struct lazy_frame_promise {
+        static void* operator new(size_t size) {
+            return lazy_frame_stack::allocate(size);
+        }
+
+        static void operator delete(void* pointer, size_t size) noexcept {
+            lazy_frame_stack::deallocate(pointer, size);
+        }
+    };
+#else
+    using lazy_frame_promise = pooled_frame_promise;
+#endif
+}  // namespace concurrencpp::details
+
+#endif
@@ -2,6 +2,7 @@
 #define CONCURRENCPP_SHARED_RESULT_STATE_H
 
 #include "concurrencpp/coroutines/coroutine.h"
+#include "concurrencpp/task_allocator.h"
 #include "concurrencpp/forward_declarations.h"
 #include "concurrencpp/results/impl/producer_context.h"
 #include "concurrencpp/results/impl/return_value_struct.h"
@@ -119,7 +120,7 @@ namespace concurrencpp::details {
     };
 
     template<class type>
-    class shared_result_promise : public return_value_struct<shared_result_promise<type>, type> {
+    class shared_result_promise : public return_value_struct<shared_result_promise<type>, type>, public pooled_frame_promise {
 
        private:
         const std::shared_ptr<shared_result_state<type>> m_state = std::make_shared<shared_result_state<type>>();
@@ -4,6 +4,7 @@
 #include "concurrencpp/task.h"
 #include "concurrencpp/coroutines/coroutine.h"
 #include "concurrencpp/results/impl/result_state.h"
+#include "concurrencpp/results/impl/lazy_frame_stack.h"
 #include "concurrencpp/results/impl/lazy_result_state.h"
 #include "concurrencpp/results/impl/return_value_struct.h"
 
@@ -29,7 +30,7 @@ namespace concurrencpp::details {
     };
 
     template<class executor_type>
-    class initialy_rescheduled_promise {
+    class initialy_rescheduled_promise : public pooled_frame_promise {
 
        protected:
         static thread_local executor_type* s_tl_initial_executor;
@@ -86,13 +87,13 @@ namespace concurrencpp::details {
     template<class executor_type>
     thread_local executor_type* initialy_rescheduled_promise<executor_type>::s_tl_initial_executor = nullptr;
 
-    struct initialy_resumed_promise {
+    struct initialy_resumed_promise : public pooled_frame_promise {
         suspend_never initial_suspend() const noexcept {
             return {};
         }
     };
 
-    struct bulk_promise {
+    struct bulk_promise : public pooled_frame_promise {
         template<class... argument_types>
         bulk_promise(executor_bulk_tag, std::vector<concurrencpp::task>& accumulator, argument_types&&...) {
             assert(coroutine_per_thread_data::s_tl_per_thread_data.accumulator == nullptr);
@@ -154,7 +155,10 @@ namespace concurrencpp::details {
     };
 
     template<class type>
-    struct lazy_promise : lazy_result_state<type>, public return_value_struct<lazy_promise<type>, type> {};
+    struct lazy_promise :
+        lazy_result_state<type>,
+        public return_value_struct<lazy_promise<type>, type>,
+        public lazy_frame_promise {};
 
     struct initialy_resumed_null_result_promise : public initialy_resumed_promise, public null_result_promise {};
 
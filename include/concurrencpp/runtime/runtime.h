@@ -3,6 +3,7 @@
 
 #include "concurrencpp/runtime/constants.h"
 #include "concurrencpp/forward_declarations.h"
+#include "concurrencpp/executors/thread_pool_executor_options.h"
 
 #include <memory>
 #include <mutex>
@@ -26,9 +27,18 @@ namespace concurrencpp {
     struct runtime_options {
         size_t max_cpu_threads;
         std::chrono::milliseconds max_thread_pool_executor_waiting_time;
+        thread_pool_executor_options cpu_pool_options;
+        bool numa_node_pools;
 
         size_t max_background_threads;
         std::chrono::milliseconds max_background_executor_waiting_time;
+        thread_pool_executor_options background_pool_options;
+
+        executor_thread_options thread_executor_options;
+        size_t max_thread_executor_cached_threads;
+        std::chrono::milliseconds max_thread_executor_waiting_time;
+
+        executor_thread_options worker_thread_executor_options;
 
         std::chrono::milliseconds max_timer_queue_waiting_time;
 
@@ -45,6 +55,8 @@ namespace concurrencpp {
         std::shared_ptr<thread_pool_executor> m_thread_pool_executor;
         std::shared_ptr<thread_pool_executor> m_background_executor;
         std::shared_ptr<thread_executor> m_thread_executor;
+        std::vector<std::shared_ptr<concurrencpp::thread_pool_executor>> m_numa_node_executors;
+        const executor_thread_options m_worker_thread_executor_options;
 
         details::executor_collection m_registered_executors;
 
@@ -62,8 +74,11 @@ namespace concurrencpp {
         std::shared_ptr<concurrencpp::thread_pool_executor> thread_pool_executor() const noexcept;
         std::shared_ptr<concurrencpp::thread_pool_executor> background_executor() const noexcept;
         std::shared_ptr<concurrencpp::thread_executor> thread_executor() const noexcept;
+        const std::vector<std::shared_ptr<concurrencpp::thread_pool_executor>>& numa_node_executors() const noexcept;
 
         std::shared_ptr<concurrencpp::worker_thread_executor> make_worker_thread_executor();
+        std::shared_ptr<concurrencpp::worker_thread_executor> make_worker_thread_executor(bool busy_poll,
+                                                                                          std::vector<size_t> cpu_affinity = {});
         std::shared_ptr<concurrencpp::manual_executor> make_manual_executor();
 
         static std::tuple<unsigned int, unsigned int, unsigned int> version() noexcept;
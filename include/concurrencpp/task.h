@@ -1,6 +1,7 @@
 #ifndef CONCURRENCPP_TASK_H
 #define CONCURRENCPP_TASK_H
 
+#include "concurrencpp/task_allocator.h"
 #include "concurrencpp/coroutines/coroutine.h"
 
 #include <type_traits>
@@ -9,10 +10,19 @@
 #include <cstddef>
 #include <cassert>
 
+// the size of concurrencpp::task in bytes, callables up to (size - sizeof(void*)) bytes are stored without allocating.
+// affects the ABI: the library and everything that includes it must be built with the same value.
+#ifndef CRCPP_TASK_SIZE
+#    define CRCPP_TASK_SIZE 64
+#endif
+
 namespace concurrencpp::details {
     struct task_constants {
-        static constexpr size_t total_size = 64;
+        static constexpr size_t total_size = CRCPP_TASK_SIZE;
         static constexpr size_t buffer_size = total_size - sizeof(void*);
+
+        static_assert(total_size % alignof(std::max_align_t) == 0 && total_size >= 2 * alignof(std::max_align_t),
+                      "concurrencpp::task - CRCPP_TASK_SIZE must be a multiple of alignof(std::max_align_t), at least 2 times it.");
     };
 
     struct vtable {
@@ -72,10 +82,31 @@ namespace concurrencpp::details {
             callable_ptr->~callable_type();
         }
 
+        // callables with an extended alignment bypass the task_allocator
+        static constexpr bool is_pooled() noexcept {
+            return alignof(callable_type) <= alignof(std::max_align_t);
+        }
+
+        static void delete_allocated(callable_type* callable_ptr) noexcept {
+            if constexpr (is_pooled()) {
+                callable_ptr->~callable_type();
+                task_allocator::deallocate(callable_ptr, sizeof(callable_type));
+            } else {
+                delete callable_ptr;
+            }
+        }
+
         static void execute_destroy_allocated(void* target) {
-            auto callable_ptr = allocated_ptr(target);
-            (*callable_ptr)();
-            delete callable_ptr;
+            struct deleter {
+                callable_type* callable_ptr;
+
+                ~deleter() noexcept {
+                    delete_allocated(callable_ptr);
+                }
+            };
+
+            const deleter deleter {allocated_ptr(target)};
+            (*deleter.callable_ptr)();
         }
 
         static void destroy_inline(void* target) noexcept {
@@ -84,8 +115,7 @@ namespace concurrencpp::details {
         }
 
         static void destroy_allocated(void* target) noexcept {
-            auto callable_ptr = allocated_ptr(target);
-            delete callable_ptr;
+            delete_allocated(allocated_ptr(target));
         }
 
         static constexpr vtable make_vtable() noexcept {
@@ -98,7 +128,7 @@ namespace concurrencpp::details {
                 move_destroy_fn = move_destroy;
             }
 
-            if constexpr (std::is_trivially_destructible_v<callable_type>) {
+            if constexpr (is_inlinable() && std::is_trivially_destructible_v<callable_type>) {
                 destroy_fn = nullptr;
             } else {
                 destroy_fn = destroy;
@@ -114,8 +144,20 @@ namespace concurrencpp::details {
 
         template<class passed_callable_type>
         static void build_allocated(void* dst, passed_callable_type&& callable) {
-            auto new_ptr = new callable_type(std::forward<passed_callable_type>(callable));
-            new (dst) callable_type*(new_ptr);
+            if constexpr (!is_pooled()) {
+                auto new_ptr = new callable_type(std::forward<passed_callable_type>(callable));
+                new (dst) callable_type*(new_ptr);
+            } else {
+                const auto storage = task_allocator::allocate(sizeof(callable_type));
+
+                try {
+                    auto new_ptr = new (storage) callable_type(std::forward<passed_callable_type>(callable));
+                    new (dst) callable_type*(new_ptr);
+                } catch (...) {
+                    task_allocator::deallocate(storage, sizeof(callable_type));
+                    throw;
+                }
+            }
         }
 
        public:
@@ -231,6 +273,15 @@ namespace concurrencpp {
         }
 
        public:
+        // whether a callable of this type is stored inside the task, or allocated
+        template<class callable_type>
+        static constexpr bool is_inlinable() noexcept {
+            return details::callable_vtable<std::decay_t<callable_type>>::is_inlinable();
+        }
+
+        // hit/miss statistics of the pool that stores the callables that aren't inlinable
+        static task_allocation_stats allocation_stats() noexcept;
+
         task() noexcept;
         task(task&& rhs) noexcept;
 
@@ -0,0 +1,56 @@
+#ifndef CONCURRENCPP_TASK_ALLOCATOR_H
+#define CONCURRENCPP_TASK_ALLOCATOR_H
+
+#include <cstddef>
+
+namespace concurrencpp {
+    struct task_allocation_stats {
+        size_t hit_count;          // allocations served by a per-thread free list
+        size_t miss_count;         // allocations that went to the global allocator
+        size_t remote_free_count;  // deallocations sent back to the thread that allocated the storage
+    };
+}  // namespace concurrencpp
+
+namespace concurrencpp::details {
+    /*
+        Storage for callables that don't fit inside a task (and coroutine frames, see pooled_frame_promise).
+        Every thread keeps a free list per size class. Storage freed by another thread (the usual case,
+        tasks are created by one thread and executed by another) is batched and pushed back to the owning thread,
+        which reclaims it on its next allocation. Bigger sizes go straight to the global allocator.
+    */
+    class task_allocator {
+
+       public:
+        static void* allocate(size_t size);
+        static void deallocate(void* pointer, size_t size) noexcept;
+
+        static task_allocation_stats stats() noexcept;
+    };
+
+    // coroutine frames share the pool of task callables
+    class coroutine_frame_allocator {
+
+       public:
+        static void* allocate(size_t size);
+        static void deallocate(void* pointer, size_t size) noexcept;
+    };
+
+    /*
+        Base of the concurrencpp promise types. When built with CRCPP_COROUTINE_FRAME_CACHE,
+        coroutine frames are allocated by the coroutine_frame_allocator instead of the global operator new.
+        The library and everything that includes it must be built with the same setting.
+    */
+    struct pooled_frame_promise {
+#ifdef CRCPP_COROUTINE_FRAME_CACHE
+        static void* operator new(size_t size) {
+            return coroutine_frame_allocator::allocate(size);
+        }
+
+        static void operator delete(void* pointer, size_t size) noexcept {
+            coroutine_frame_allocator::deallocate(pointer, size);
+        }
+#endif
+    };
+}  // namespace concurrencpp::details
+
+#endif
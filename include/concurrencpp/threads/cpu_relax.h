@@ -0,0 +1,25 @@
+#ifndef CONCURRENCPP_CPU_RELAX_H
+#define CONCURRENCPP_CPU_RELAX_H
+
+#include "concurrencpp/platform_defs.h"
+
+#if defined(CRCPP_MSVC_COMPILER)
+#    include <intrin.h>
+#endif
+
+namespace concurrencpp::details {
+    // hints the cpu that we're in a spin-wait loop.
+    inline void cpu_relax() noexcept {
+#if defined(CRCPP_MSVC_COMPILER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(CRCPP_MSVC_COMPILER) && defined(_M_ARM64)
+        __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+}  // namespace concurrencpp::details
+
+#endif
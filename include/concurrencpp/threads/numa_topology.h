@@ -0,0 +1,41 @@
+#ifndef CONCURRENCPP_NUMA_TOPOLOGY_H
+#define CONCURRENCPP_NUMA_TOPOLOGY_H
+
+#include <vector>
+
+#include <cstddef>
+
+namespace concurrencpp::details {
+    struct numa_node {
+        size_t id;
+        std::vector<size_t> cpus;
+    };
+
+    /*
+        The NUMA nodes of this machine and the cpus that belong to each one of them.
+        On Linux the topology is read from /sys/devices/system/node, everywhere else (or if reading fails)
+        the machine is described as a single node that holds all the cpus.
+    */
+    class numa_topology {
+
+       private:
+        std::vector<numa_node> m_nodes;
+        std::vector<size_t> m_cpu_to_node;
+
+       public:
+        numa_topology(std::vector<numa_node> nodes);
+
+        static const numa_topology& system();
+        static std::vector<numa_node> detect_nodes();
+        static std::vector<size_t> parse_cpu_list(const char* cpu_list);
+
+        const std::vector<numa_node>& nodes() const noexcept;
+
+        // the position of the node in nodes(), static_cast<size_t>(-1) if the node or the cpu is unknown
+        size_t index_of_node(size_t node_id) const noexcept;
+        size_t node_index_of_cpu(size_t cpu) const noexcept;
+        size_t current_node_index() const noexcept;
+    };
+}  // namespace concurrencpp::details
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef CONCURRENCPP_THREAD_H
 #define CONCURRENCPP_THREAD_H
 
+#include "concurrencpp/threads/thread_options.h"
+
+#include <span>
 #include <string_view>
 #include <thread>
 
@@ -12,16 +15,38 @@ namespace concurrencpp::details {
 
         static void set_name(std::string_view name) noexcept;
 
+        static void on_thread_start(std::string_view name, const executor_thread_options& options);
+        static void on_thread_stop(std::string_view name, const executor_thread_options& options);
+
+        // runs on_thread_stop when the callable returns or throws
+        struct thread_stop_guard {
+            std::string_view name;
+            const executor_thread_options& options;
+
+            ~thread_stop_guard() noexcept {
+                on_thread_stop(name, options);
+            }
+        };
+
        public:
         thread() noexcept = default;
         thread(thread&&) noexcept = default;
 
+        // thread_options, if given, must outlive the thread.
         template<class callable_type>
-        thread(std::string name, callable_type&& callable) {
-            m_thread = std::thread([name = std::move(name), callable = std::forward<callable_type>(callable)]() mutable {
-                set_name(name);
-                callable();
-            });
+        thread(std::string name, callable_type&& callable, const executor_thread_options* thread_options = nullptr) {
+            m_thread = std::thread(
+                [name = std::move(name), thread_options, callable = std::forward<callable_type>(callable)]() mutable {
+                    set_name(name);
+
+                    if (thread_options == nullptr) {
+                        return callable();
+                    }
+
+                    on_thread_start(name, *thread_options);
+                    thread_stop_guard stop_guard {name, *thread_options};
+                    callable();
+                });
         }
 
         thread& operator=(thread&& rhs) noexcept = default;
@@ -34,6 +59,10 @@ namespace concurrencpp::details {
         void join();
 
         static size_t hardware_concurrency() noexcept;
+
+        // both apply to the calling thread. current_cpu returns static_cast<size_t>(-1) if it can't be queried.
+        static bool set_affinity(std::span<const size_t> cpus) noexcept;
+        static size_t current_cpu() noexcept;
     };
 }  // namespace concurrencpp::details
 
@@ -0,0 +1,24 @@
+#ifndef CONCURRENCPP_THREAD_OPTIONS_H
+#define CONCURRENCPP_THREAD_OPTIONS_H
+
+#include <vector>
+#include <functional>
+#include <string_view>
+
+#include <cstddef>
+
+namespace concurrencpp {
+    /*
+        Applied to every thread an executor creates.
+        cpu_affinity - the cpus the threads are allowed to run on, no restriction if empty.
+        on_thread_start, on_thread_stop - invoked by each thread (with its name) before it starts
+        and after it finishes its work loop. the callbacks must not throw.
+    */
+    struct executor_thread_options {
+        std::vector<size_t> cpu_affinity;
+        std::function<void(std::string_view thread_name)> on_thread_start;
+        std::function<void(std::string_view thread_name)> on_thread_stop;
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -0,0 +1,356 @@
+#include "concurrencpp/errors.h"
+#include "concurrencpp/results/resume_on.h"
+#include "concurrencpp/executors/constants.h"
+#include "concurrencpp/executors/bounded_executor.h"
+
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+#include <stdexcept>
+#include <condition_variable>
+
+using concurrencpp::executor;
+using concurrencpp::queue_full_policy;
+using concurrencpp::bounded_executor;
+
+struct bounded_executor::bounded_state : public std::enable_shared_from_this<bounded_state> {
+
+    class admission_awaiter {
+
+       private:
+        bounded_state& m_parent;
+        std::unique_lock<std::mutex> m_lock;
+
+       public:
+        task& pending_task;
+        admission_awaiter* next = nullptr;
+        details::coroutine_handle<void> resume_handle;
+        bool interrupted = false;
+
+        admission_awaiter(bounded_state& parent, std::unique_lock<std::mutex>& lock, task& pending_task) noexcept :
+            m_parent(parent), m_lock(std::move(lock)), pending_task(pending_task) {}
+
+        static bool await_ready() noexcept {
+            return false;
+        }
+
+        void await_suspend(details::coroutine_handle<void> handle) {
+            assert(m_lock.owns_lock());
+
+            resume_handle = handle;
+            m_parent.enqueue_awaiter(*this);
+
+            auto lock = std::move(m_lock);  // will unlock underlying lock
+        }
+
+        void await_resume() const {
+            if (interrupted) {
+                details::throw_runtime_shutdown_exception(m_parent.name);
+            }
+        }
+    };
+
+    const std::string name;
+    const std::shared_ptr<executor> underlying_executor;
+    const size_t capacity;
+    const queue_full_policy policy;
+    std::mutex lock;
+    std::condition_variable condition;
+    std::deque<task> tasks;
+    size_t taken_count = 0;  // tasks that were popped from the front of the queue, by a runner or by drop_oldest
+    admission_awaiter* awaiter_head = nullptr;
+    admission_awaiter* awaiter_tail = nullptr;
+    bool abort = false;
+    std::atomic_bool atomic_abort;
+    std::atomic_size_t dropped_task_count;
+
+    bounded_state(std::string_view name, std::shared_ptr<executor> underlying_executor, size_t capacity, queue_full_policy policy) :
+        name(name), underlying_executor(std::move(underlying_executor)), capacity(capacity), policy(policy), atomic_abort(false),
+        dropped_task_count(0) {}
+
+    void enqueue_awaiter(admission_awaiter& awaiter) noexcept {
+        if (awaiter_head == nullptr) {
+            awaiter_head = awaiter_tail = &awaiter;
+            return;
+        }
+
+        awaiter_tail->next = &awaiter;
+        awaiter_tail = &awaiter;
+    }
+
+    admission_awaiter* try_dequeue_awaiter() noexcept {
+        const auto awaiter = awaiter_head;
+        if (awaiter == nullptr) {
+            return nullptr;
+        }
+
+        awaiter_head = awaiter->next;
+        if (awaiter_head == nullptr) {
+            awaiter_tail = nullptr;
+        }
+
+        return awaiter;
+    }
+
+    // a runner that is destroyed without running (e.g. the underlying executor was shut down with the runner still queued,
+    // or rejected it) would leave its task occupying a slot forever, so none of the queued tasks will run anymore.
+    class runner_task {
+
+       private:
+        std::shared_ptr<bounded_state> m_state;
+
+       public:
+        explicit runner_task(std::shared_ptr<bounded_state> state) noexcept : m_state(std::move(state)) {}
+
+        runner_task(runner_task&& rhs) noexcept = default;
+
+        ~runner_task() noexcept {
+            if (static_cast<bool>(m_state)) {
+                m_state->shutdown();
+            }
+        }
+
+        void operator()() {
+            const auto state = std::move(m_state);
+            state->run_one();
+        }
+    };
+
+    // every queued task has exactly one runner in the underlying executor, a runner executes the oldest queued task
+    void schedule_runners(size_t count) {
+        if (count == 1) {
+            underlying_executor->enqueue(task(runner_task(shared_from_this())));
+            return;
+        }
+
+        std::vector<task> runners;
+        runners.reserve(count);
+
+        for (size_t i = 0; i < count; i++) {
+            runners.emplace_back(runner_task(shared_from_this()));
+        }
+
+        underlying_executor->enqueue(std::span<task>(runners));
+    }
+
+    void push(std::span<task> new_tasks) {
+        std::deque<task> dropped_tasks;
+        size_t runner_count = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(this->lock);
+            if (abort) {
+                details::throw_runtime_shutdown_exception(name);
+            }
+
+            if (policy == queue_full_policy::throw_exception && tasks.size() + new_tasks.size() > capacity) {
+                throw errors::queue_full(details::consts::k_bounded_executor_queue_full_err_msg);
+            }
+
+            for (auto& new_task : new_tasks) {
+                if (tasks.size() < capacity) {
+                    tasks.emplace_back(std::move(new_task));
+                    ++runner_count;
+                    continue;
+                }
+
+                if (policy == queue_full_policy::drop_oldest) {
+                    // the dropped task's runner will execute the new task.
+                    dropped_tasks.emplace_back(std::move(tasks.front()));
+                    tasks.pop_front();
+                    ++taken_count;
+                    tasks.emplace_back(std::move(new_task));
+                    dropped_task_count.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                assert(policy == queue_full_policy::block);
+
+                // the tasks that were queued so far must be able to run while we wait for them to make room.
+                if (runner_count != 0) {
+                    lock.unlock();
+                    schedule_runners(std::exchange(runner_count, 0));
+                    lock.lock();
+                }
+
+                condition.wait(lock, [this] {
+                    return tasks.size() < capacity || abort;
+                });
+
+                if (abort) {
+                    details::throw_runtime_shutdown_exception(name);
+                }
+
+                tasks.emplace_back(std::move(new_task));
+                ++runner_count;
+            }
+        }
+
+        if (runner_count != 0) {
+            schedule_runners(runner_count);
+        }
+    }
+
+    void run_one() {
+        task task;
+        admission_awaiter* admitted = nullptr;
+        size_t admitted_position = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(this->lock);
+            if (tasks.empty()) {
+                return;  // dropped by shutdown
+            }
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            ++taken_count;
+
+            // a suspended post_async takes the free slot before anyone else, this runner's slot is handed to it.
+            if (awaiter_head != nullptr) {
+                tasks.emplace_back(std::move(awaiter_head->pending_task));
+                admitted = try_dequeue_awaiter();
+                admitted_position = taken_count + tasks.size() - 1;
+            }
+        }
+
+        std::exception_ptr schedule_error;
+
+        if (admitted != nullptr) {
+            try {
+                schedule_runners(1);
+            } catch (const errors::runtime_shutdown&) {
+                // the underlying executor was shut down, the admitted task can't run anymore.
+                // post_async fails, unless another runner has already taken the admitted task.
+                admitted->interrupted = shutdown() <= admitted_position;
+            } catch (...) {
+                // the lost runner has shut the queue down, the admitted producer must not stay suspended.
+                admitted->interrupted = shutdown() <= admitted_position;
+                schedule_error = std::current_exception();
+            }
+
+            admitted->resume_handle.resume();
+        } else if (policy == queue_full_policy::block) {
+            condition.notify_one();
+        }
+
+        task();
+
+        if (static_cast<bool>(schedule_error)) {
+            std::rethrow_exception(schedule_error);
+        }
+    }
+
+    // returns how many tasks had been taken from the queue before it was cleared
+    size_t shutdown() {
+        std::deque<task> dropped_tasks;
+        admission_awaiter* awaiters = nullptr;
+        size_t taken_before_shutdown = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(this->lock);
+            abort = true;
+            atomic_abort.store(true, std::memory_order_relaxed);
+            taken_before_shutdown = taken_count;
+            dropped_tasks = std::move(tasks);
+            tasks.clear();
+            awaiters = std::exchange(awaiter_head, nullptr);
+            awaiter_tail = nullptr;
+        }
+
+        condition.notify_all();
+
+        while (awaiters != nullptr) {
+            auto awaiter = std::exchange(awaiters, awaiters->next);
+            awaiter->interrupted = true;
+            awaiter->resume_handle.resume();
+        }
+
+        return taken_before_shutdown;
+    }
+};
+
+bounded_executor::bounded_executor(std::shared_ptr<executor> underlying_executor, size_t capacity, queue_full_policy policy) :
+    derivable_executor<concurrencpp::bounded_executor>(details::consts::k_bounded_executor_name),
+    m_state([&] {
+        if (!static_cast<bool>(underlying_executor)) {
+            throw std::invalid_argument(details::consts::k_bounded_executor_null_executor_err_msg);
+        }
+
+        if (capacity == 0) {
+            throw std::invalid_argument(details::consts::k_bounded_executor_invalid_capacity_err_msg);
+        }
+
+        return std::make_shared<bounded_state>(details::consts::k_bounded_executor_name,
+                                               std::move(underlying_executor),
+                                               capacity,
+                                               policy);
+    }()) {}
+
+concurrencpp::lazy_result<void> bounded_executor::post_async_impl(std::shared_ptr<executor> resume_executor, concurrencpp::task task) {
+    const auto state = m_state;
+
+    std::unique_lock<std::mutex> lock(state->lock);
+    if (state->abort) {
+        details::throw_runtime_shutdown_exception(state->name);
+    }
+
+    // queue behind the coroutines that are already waiting for a free slot
+    if (state->tasks.size() < state->capacity && state->awaiter_head == nullptr) {
+        state->tasks.emplace_back(std::move(task));
+        lock.unlock();
+
+        state->schedule_runners(1);
+        co_return;
+    }
+
+    co_await bounded_state::admission_awaiter(*state, lock, task);
+    co_await resume_on(resume_executor);
+}
+
+void bounded_executor::enqueue(concurrencpp::task task) {
+    m_state->push(std::span<concurrencpp::task>(&task, 1));
+}
+
+void bounded_executor::enqueue(std::span<concurrencpp::task> tasks) {
+    m_state->push(tasks);
+}
+
+int bounded_executor::max_concurrency_level() const noexcept {
+    return m_state->underlying_executor->max_concurrency_level();
+}
+
+bool bounded_executor::shutdown_requested() const {
+    return m_state->atomic_abort.load(std::memory_order_relaxed);
+}
+
+void bounded_executor::shutdown() {
+    const auto abort = m_state->atomic_abort.exchange(true, std::memory_order_relaxed);
+    if (abort) {
+        return;  // shutdown had been called before.
+    }
+
+    m_state->shutdown();
+}
+
+std::shared_ptr<executor> bounded_executor::underlying_executor() const noexcept {
+    return m_state->underlying_executor;
+}
+
+size_t bounded_executor::capacity() const noexcept {
+    return m_state->capacity;
+}
+
+queue_full_policy bounded_executor::policy() const noexcept {
+    return m_state->policy;
+}
+
+size_t bounded_executor::size() const {
+    std::unique_lock<std::mutex> lock(m_state->lock);
+    return m_state->tasks.size();
+}
+
+size_t bounded_executor::dropped_task_count() const noexcept {
+    return m_state->dropped_task_count.load(std::memory_order_relaxed);
+}
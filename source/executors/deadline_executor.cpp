@@ -0,0 +1,269 @@
+#include "concurrencpp/timers/timer_queue.h"
+#include "concurrencpp/executors/constants.h"
+#include "concurrencpp/executors/deadline_executor.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace concurrencpp::details {
+    static thread_local const deadline_executor* s_tl_this_executor = nullptr;
+    static thread_local size_t s_tl_this_worker_index = 0;
+}  // namespace concurrencpp::details
+
+using concurrencpp::deadline_executor;
+using concurrencpp::deadline_miss_policy;
+
+static_assert(std::is_same_v<deadline_executor::clock_type, concurrencpp::timer_queue::clock_type>,
+              "concurrencpp::deadline_executor - deadlines must use the clock of timer_queue.");
+
+deadline_executor::deadline_executor(std::string_view pool_name, size_t pool_size, const executor_thread_options& thread_options) :
+    derivable_executor<concurrencpp::deadline_executor>(pool_name), m_sequence(0), m_round_robin_cursor(0), m_queued_count(0),
+    m_idle_count(0), m_abort(false), m_missed_deadline_count(0), m_dropped_task_count(0), m_thread_options(thread_options) {
+    if (pool_size == 0) {
+        throw std::invalid_argument(details::consts::k_deadline_executor_invalid_pool_size_err_msg);
+    }
+
+    m_workers.reserve(pool_size);
+    for (size_t i = 0; i < pool_size; i++) {
+        m_workers.emplace_back(std::make_unique<worker>());
+    }
+
+    m_threads.reserve(pool_size);
+
+    try {
+        for (size_t i = 0; i < pool_size; i++) {
+            m_threads.emplace_back(
+                details::make_executor_worker_name(name),
+                [this, i] {
+                    work_loop(i);
+                },
+                &m_thread_options);
+        }
+    } catch (...) {
+        // the threads that were already started use this object, they must be joined before it is destroyed
+        m_abort.store(true, std::memory_order_relaxed);
+
+        { std::unique_lock<std::mutex> lock(m_lock); }
+        m_condition.notify_all();
+
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+
+        throw;
+    }
+}
+
+bool deadline_executor::executes_later(const deadline_task& a, const deadline_task& b) noexcept {
+    // heap order: the earliest deadline on top, ties are broken by enqueuing order.
+    if (a.deadline != b.deadline) {
+        return a.deadline > b.deadline;
+    }
+
+    return a.sequence > b.sequence;
+}
+
+size_t deadline_executor::target_worker() noexcept {
+    if (details::s_tl_this_executor == this) {
+        return details::s_tl_this_worker_index;
+    }
+
+    return m_round_robin_cursor.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+}
+
+void deadline_executor::push(size_t worker_index, std::span<task> tasks, time_point deadline, deadline_miss_policy policy) {
+    if (m_abort.load(std::memory_order_relaxed)) {
+        details::throw_runtime_shutdown_exception(name);
+    }
+
+    if (tasks.empty()) {
+        return;
+    }
+
+    auto sequence = m_sequence.fetch_add(tasks.size(), std::memory_order_relaxed);
+    auto& worker = *m_workers[worker_index];
+
+    {
+        std::unique_lock<std::mutex> lock(worker.lock);
+
+        // shutdown drains the heaps under their locks after it sets m_abort, a task that is inserted later would never run
+        if (m_abort.load(std::memory_order_relaxed)) {
+            details::throw_runtime_shutdown_exception(name);
+        }
+
+        // every task that enters the heap has to be counted, so the heap can't be allowed to throw halfway through
+        worker.heap.reserve(worker.heap.size() + tasks.size());
+
+        for (auto& task : tasks) {
+            worker.heap.emplace_back(deadline_task {deadline, sequence++, policy, std::move(task)});
+            std::push_heap(worker.heap.begin(), worker.heap.end(), executes_later);
+        }
+    }
+
+    // pairs with wait_for_task: either the idle worker sees the new count or we see the idle worker.
+    m_queued_count.fetch_add(static_cast<intptr_t>(tasks.size()), std::memory_order_seq_cst);
+    if (m_idle_count.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+
+    { std::unique_lock<std::mutex> lock(m_lock); }
+
+    if (tasks.size() == 1) {
+        m_condition.notify_one();
+    } else {
+        m_condition.notify_all();
+    }
+}
+
+bool deadline_executor::pop(size_t worker_index, deadline_task& task) {
+    auto& worker = *m_workers[worker_index];
+
+    {
+        std::unique_lock<std::mutex> lock(worker.lock);
+        if (worker.heap.empty()) {
+            return false;
+        }
+
+        std::pop_heap(worker.heap.begin(), worker.heap.end(), executes_later);
+        task = std::move(worker.heap.back());
+        worker.heap.pop_back();
+    }
+
+    m_queued_count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool deadline_executor::steal(size_t worker_index, deadline_task& task) {
+    // find the worker that holds the earliest deadline, then take its earliest task
+    // (which might have changed in the meantime, but is still a good candidate).
+    const auto worker_count = m_workers.size();
+    auto best_index = worker_index;
+    time_point best_deadline = time_point::max();
+    std::uint64_t best_sequence = 0;
+
+    for (size_t i = 1; i < worker_count; i++) {
+        const auto victim_index = (worker_index + i) % worker_count;
+        auto& victim = *m_workers[victim_index];
+
+        std::unique_lock<std::mutex> lock(victim.lock);
+        if (victim.heap.empty()) {
+            continue;
+        }
+
+        const auto& top = victim.heap.front();
+        if (best_index == worker_index || top.deadline < best_deadline ||
+            (top.deadline == best_deadline && top.sequence < best_sequence)) {
+            best_index = victim_index;
+            best_deadline = top.deadline;
+            best_sequence = top.sequence;
+        }
+    }
+
+    if (best_index == worker_index) {
+        return false;
+    }
+
+    return pop(best_index, task);
+}
+
+bool deadline_executor::wait_for_task() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_idle_count.fetch_add(1, std::memory_order_seq_cst);
+
+    m_condition.wait(lock, [this] {
+        return m_queued_count.load(std::memory_order_seq_cst) > 0 || m_abort.load(std::memory_order_relaxed);
+    });
+
+    m_idle_count.fetch_sub(1, std::memory_order_relaxed);
+    return !m_abort.load(std::memory_order_relaxed);
+}
+
+void deadline_executor::execute(deadline_task& task) {
+    auto callable = std::move(task.callable);
+
+    if (task.deadline != time_point::max() && clock_type::now() > task.deadline) {
+        m_missed_deadline_count.fetch_add(1, std::memory_order_relaxed);
+
+        if (task.policy == deadline_miss_policy::drop) {
+            m_dropped_task_count.fetch_add(1, std::memory_order_relaxed);
+            return;  // destroying a task that wasn't executed breaks its result.
+        }
+    }
+
+    callable();
+}
+
+void deadline_executor::work_loop(size_t worker_index) {
+    details::s_tl_this_executor = this;
+    details::s_tl_this_worker_index = worker_index;
+
+    deadline_task task;
+    while (!m_abort.load(std::memory_order_relaxed)) {
+        if (pop(worker_index, task) || steal(worker_index, task)) {
+            execute(task);
+            continue;
+        }
+
+        if (!wait_for_task()) {
+            break;
+        }
+    }
+}
+
+void deadline_executor::enqueue(concurrencpp::task task) {
+    push(target_worker(), std::span<concurrencpp::task>(&task, 1), time_point::max(), deadline_miss_policy::execute);
+}
+
+void deadline_executor::enqueue(std::span<concurrencpp::task> tasks) {
+    push(target_worker(), tasks, time_point::max(), deadline_miss_policy::execute);
+}
+
+void deadline_executor::enqueue(concurrencpp::task task, time_point deadline, deadline_miss_policy policy) {
+    push(target_worker(), std::span<concurrencpp::task>(&task, 1), deadline, policy);
+}
+
+void deadline_executor::enqueue(std::span<concurrencpp::task> tasks, time_point deadline, deadline_miss_policy policy) {
+    push(target_worker(), tasks, deadline, policy);
+}
+
+int deadline_executor::max_concurrency_level() const noexcept {
+    return static_cast<int>(m_workers.size());
+}
+
+bool deadline_executor::shutdown_requested() const {
+    return m_abort.load(std::memory_order_relaxed);
+}
+
+void deadline_executor::shutdown() {
+    const auto abort = m_abort.exchange(true, std::memory_order_relaxed);
+    if (abort) {
+        return;  // shutdown had been called before.
+    }
+
+    { std::unique_lock<std::mutex> lock(m_lock); }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    // push checks m_abort under the worker lock, so a task is either drained here or rejected by push
+    for (auto& worker : m_workers) {
+        std::vector<deadline_task> tasks;
+
+        {
+            std::unique_lock<std::mutex> lock(worker->lock);
+            tasks = std::move(worker->heap);
+        }
+    }
+}
+
+size_t deadline_executor::missed_deadline_count() const noexcept {
+    return m_missed_deadline_count.load(std::memory_order_relaxed);
+}
+
+size_t deadline_executor::dropped_task_count() const noexcept {
+    return m_dropped_task_count.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,170 @@
+#include "concurrencpp/task_allocator.h"
+#include "concurrencpp/executors/impl/mpsc_task_queue.h"
+
+#include <memory>
+
+using concurrencpp::task;
+using concurrencpp::details::mpsc_push_status;
+using concurrencpp::details::mpsc_task_queue;
+
+void* mpsc_task_queue::node::operator new(size_t size) {
+    return task_allocator::allocate(size);
+}
+
+void mpsc_task_queue::node::operator delete(void* pointer, size_t size) noexcept {
+    task_allocator::deallocate(pointer, size);
+}
+
+mpsc_task_queue::mpsc_task_queue() noexcept : m_head(nullptr), m_backlog(nullptr) {}
+
+mpsc_task_queue::~mpsc_task_queue() noexcept {
+    const auto head = m_head.load(std::memory_order_acquire);
+    if (head != closed_tag()) {
+        destroy_list(head);
+    }
+
+    destroy_list(m_backlog.load(std::memory_order_relaxed));
+}
+
+mpsc_task_queue::node* mpsc_task_queue::closed_tag() const noexcept {
+    // never dereferenced, only compared against.
+    return reinterpret_cast<node*>(const_cast<mpsc_task_queue*>(this));
+}
+
+void mpsc_task_queue::destroy_list(node* head) noexcept {
+    while (head != nullptr) {
+        delete std::exchange(head, head->next);
+    }
+}
+
+mpsc_push_status mpsc_task_queue::push_node(node* new_node) noexcept {
+    auto head = m_head.load(std::memory_order_relaxed);
+
+    do {
+        if (head == closed_tag()) {
+            delete new_node;
+            return mpsc_push_status::closed;
+        }
+
+        new_node->next = head;
+    } while (!m_head.compare_exchange_weak(head, new_node, std::memory_order_release, std::memory_order_relaxed));
+
+    return (head == nullptr) ? mpsc_push_status::first : mpsc_push_status::appended;
+}
+
+mpsc_push_status mpsc_task_queue::push(task& task, size_t lane) {
+    auto new_node = std::make_unique<node>();
+    new_node->lane = lane;
+    new_node->single_task = std::move(task);
+    return push_node(new_node.release());
+}
+
+mpsc_push_status mpsc_task_queue::push(std::span<task> tasks, size_t lane) {
+    if (tasks.empty()) {
+        return mpsc_push_status::appended;  // nothing to notify about
+    }
+
+    auto new_node = std::make_unique<node>();
+    new_node->lane = lane;
+    new_node->tasks.reserve(tasks.size());
+    new_node->tasks.insert(new_node->tasks.end(), std::make_move_iterator(tasks.begin()), std::make_move_iterator(tasks.end()));
+    return push_node(new_node.release());
+}
+
+size_t mpsc_task_queue::pop_all(std::deque<task>& destination) {
+    return pop_all(std::span<std::deque<task>>(&destination, 1));
+}
+
+mpsc_task_queue::node* mpsc_task_queue::pop_node_tasks(node* current,
+                                                        std::span<std::deque<task>> destinations,
+                                                        size_t& count) {
+    assert(current->lane < destinations.size());
+    auto& destination = destinations[current->lane];
+
+    if (current->tasks.empty()) {
+        destination.emplace_back(std::move(current->single_task));
+        ++count;
+        return current->next;
+    }
+
+    // one by one, so a throwing emplace_back leaves the tasks that weren't moved in the node
+    size_t moved = 0;
+    try {
+        for (auto& pushed_task : current->tasks) {
+            destination.emplace_back(std::move(pushed_task));
+            ++moved;
+        }
+    } catch (...) {
+        current->tasks.erase(current->tasks.begin(), current->tasks.begin() + static_cast<std::ptrdiff_t>(moved));
+        throw;
+    }
+
+    count += moved;
+    return current->next;
+}
+
+size_t mpsc_task_queue::pop_all(std::span<std::deque<task>> destinations) {
+    assert(!destinations.empty());
+
+    auto head = m_head.load(std::memory_order_relaxed);
+
+    do {
+        if (head == closed_tag()) {
+            destroy_list(m_backlog.exchange(nullptr, std::memory_order_relaxed));
+            return 0;
+        }
+
+        if (head == nullptr) {
+            break;
+        }
+    } while (!m_head.compare_exchange_weak(head, nullptr, std::memory_order_acquire, std::memory_order_relaxed));
+
+    // nodes were pushed in LIFO order
+    node* reversed = nullptr;
+    while (head != nullptr) {
+        auto next = head->next;
+        head->next = reversed;
+        reversed = head;
+        head = next;
+    }
+
+    // nodes left over by a previous, throwing call come first
+    auto pending = m_backlog.exchange(nullptr, std::memory_order_relaxed);
+    if (pending == nullptr) {
+        pending = reversed;
+    } else {
+        auto tail = pending;
+        while (tail->next != nullptr) {
+            tail = tail->next;
+        }
+
+        tail->next = reversed;
+    }
+
+    size_t count = 0;
+    while (pending != nullptr) {
+        node* next;
+        try {
+            next = pop_node_tasks(pending, destinations, count);
+        } catch (...) {
+            m_backlog.store(pending, std::memory_order_relaxed);
+            throw;
+        }
+
+        delete std::exchange(pending, next);
+    }
+
+    return count;
+}
+
+bool mpsc_task_queue::empty() const noexcept {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    return (head == nullptr || head == closed_tag()) && m_backlog.load(std::memory_order_relaxed) == nullptr;
+}
+
+void mpsc_task_queue::close() noexcept {
+    const auto head = m_head.exchange(closed_tag(), std::memory_order_acquire);
+    if (head != closed_tag()) {
+        destroy_list(head);
+    }
+}
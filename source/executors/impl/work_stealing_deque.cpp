@@ -0,0 +1,170 @@
+#include "concurrencpp/executors/impl/work_stealing_deque.h"
+
+#include <bit>
+#include <thread>
+
+using concurrencpp::task;
+using concurrencpp::details::work_stealing_deque;
+
+work_stealing_deque::work_stealing_deque(size_t initial_capacity) :
+    m_top(0), m_steal_lock(false), m_bottom(0), m_slots(std::make_unique<task[]>(std::bit_ceil(initial_capacity))),
+    m_mask(static_cast<std::int64_t>(std::bit_ceil(initial_capacity)) - 1) {
+    assert(initial_capacity > 1);
+}
+
+task& work_stealing_deque::slot_at(std::int64_t index) noexcept {
+    return m_slots[static_cast<size_t>(index & m_mask)];
+}
+
+bool work_stealing_deque::try_lock_steal() noexcept {
+    if (m_steal_lock.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    return !m_steal_lock.exchange(true, std::memory_order_acquire);
+}
+
+void work_stealing_deque::lock_steal() noexcept {
+    while (!try_lock_steal()) {
+        std::this_thread::yield();
+    }
+}
+
+void work_stealing_deque::unlock_steal() noexcept {
+    m_steal_lock.store(false, std::memory_order_release);
+}
+
+void work_stealing_deque::reallocate(std::int64_t new_capacity) {
+    // allocate before locking, thieves only make the deque smaller in the meantime.
+    auto new_slots = std::make_unique<task[]>(static_cast<size_t>(new_capacity));
+    const auto new_mask = new_capacity - 1;
+
+    lock_steal();
+
+    const auto current_top = m_top.load(std::memory_order_relaxed);
+    const auto current_bottom = m_bottom.load(std::memory_order_relaxed);
+
+    for (auto i = current_top; i < current_bottom; i++) {
+        new_slots[static_cast<size_t>(i & new_mask)] = std::move(slot_at(i));
+    }
+
+    m_slots = std::move(new_slots);
+    m_mask = new_mask;
+
+    unlock_steal();
+}
+
+void work_stealing_deque::grow(std::int64_t top, std::int64_t required_bottom) {
+    assert(required_bottom >= top);
+
+    auto new_capacity = (m_mask + 1) * 2;
+    while (new_capacity - 1 < required_bottom - top) {
+        new_capacity *= 2;
+    }
+
+    reallocate(new_capacity);
+}
+
+void work_stealing_deque::relocate() {
+    reallocate(m_mask + 1);
+}
+
+void work_stealing_deque::push(task& task) {
+    const auto bottom = m_bottom.load(std::memory_order_relaxed);
+    const auto top = m_top.load(std::memory_order_acquire);
+
+    // one slot is always kept free for a thief that is still moving the top task out.
+    if (bottom - top >= m_mask) {
+        grow(top, bottom + 1);
+    }
+
+    slot_at(bottom) = std::move(task);
+    m_bottom.store(bottom + 1, std::memory_order_release);
+}
+
+void work_stealing_deque::push(std::span<task> tasks) {
+    const auto bottom = m_bottom.load(std::memory_order_relaxed);
+    const auto top = m_top.load(std::memory_order_acquire);
+    const auto count = static_cast<std::int64_t>(tasks.size());
+
+    if (bottom - top + count > m_mask) {
+        grow(top, bottom + count);
+    }
+
+    for (std::int64_t i = 0; i < count; i++) {
+        slot_at(bottom + i) = std::move(tasks[static_cast<size_t>(i)]);
+    }
+
+    m_bottom.store(bottom + count, std::memory_order_release);
+}
+
+bool work_stealing_deque::pop(task& task) noexcept {
+    const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto top = m_top.load(std::memory_order_relaxed);
+
+    if (top < bottom) {
+        task = std::move(slot_at(bottom));
+        return true;
+    }
+
+    if (top > bottom) {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // last task, a thief might be racing us for it.
+    lock_steal();
+
+    const auto found = (m_top.load(std::memory_order_relaxed) == bottom);
+    if (found) {
+        task = std::move(slot_at(bottom));
+    } else {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    unlock_steal();
+    return found;
+}
+
+bool work_stealing_deque::steal(task& task) noexcept {
+    if (!try_lock_steal()) {
+        return false;
+    }
+
+    const auto top = m_top.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto bottom = m_bottom.load(std::memory_order_acquire);
+
+    const auto found = (top < bottom);
+    if (found) {
+        task = std::move(slot_at(top));
+        m_top.store(top + 1, std::memory_order_release);
+    }
+
+    unlock_steal();
+    return found;
+}
+
+size_t work_stealing_deque::size() const noexcept {
+    const auto bottom = m_bottom.load(std::memory_order_relaxed);
+    const auto top = m_top.load(std::memory_order_relaxed);
+    return (bottom > top) ? static_cast<size_t>(bottom - top) : 0;
+}
+
+bool work_stealing_deque::empty() const noexcept {
+    return size() == 0;
+}
+
+void work_stealing_deque::clear() noexcept {
+    const auto bottom = m_bottom.load(std::memory_order_relaxed);
+    const auto top = m_top.load(std::memory_order_relaxed);
+
+    for (auto i = top; i < bottom; i++) {
+        slot_at(i).clear();
+    }
+
+    m_top.store(0, std::memory_order_relaxed);
+    m_bottom.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,120 @@
+#include "concurrencpp/executors/constants.h"
+#include "concurrencpp/executors/keyed_executor.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <cstdint>
+
+using concurrencpp::executor;
+using concurrencpp::keyed_executor;
+using concurrencpp::strand_executor;
+
+keyed_executor::keyed_executor(std::shared_ptr<executor> underlying_executor, size_t lane_count, size_t max_batch_size) :
+    derivable_executor<concurrencpp::keyed_executor>(details::consts::k_keyed_executor_name), m_round_robin_cursor(0), m_abort(false),
+    m_underlying_executor(std::move(underlying_executor)) {
+    if (!static_cast<bool>(m_underlying_executor)) {
+        throw std::invalid_argument(details::consts::k_keyed_executor_null_executor_err_msg);
+    }
+
+    if (lane_count == 0) {
+        throw std::invalid_argument(details::consts::k_keyed_executor_invalid_lane_count_err_msg);
+    }
+
+    m_lanes.reserve(lane_count);
+    for (size_t i = 0; i < lane_count; i++) {
+        m_lanes.emplace_back(std::make_shared<strand_executor>(m_underlying_executor, max_batch_size));
+    }
+}
+
+size_t keyed_executor::mix_hash(size_t hash) noexcept {
+    // std::hash is the identity for integers on common implementations, mix it so consecutive keys don't form patterns.
+    auto mixed = static_cast<std::uint64_t>(hash);
+    mixed ^= mixed >> 33;
+    mixed *= 0xff51afd7ed558ccdULL;
+    mixed ^= mixed >> 33;
+    return static_cast<size_t>(mixed);
+}
+
+void keyed_executor::enqueue(concurrencpp::task task) {
+    if (m_abort.load(std::memory_order_relaxed)) {
+        details::throw_runtime_shutdown_exception(name);
+    }
+
+    const auto index = m_round_robin_cursor.fetch_add(1, std::memory_order_relaxed) % m_lanes.size();
+    m_lanes[index]->enqueue(std::move(task));
+}
+
+void keyed_executor::enqueue(std::span<concurrencpp::task> tasks) {
+    if (m_abort.load(std::memory_order_relaxed)) {
+        details::throw_runtime_shutdown_exception(name);
+    }
+
+    const auto lane_count = m_lanes.size();
+    const auto chunk_size = (tasks.size() + lane_count - 1) / lane_count;
+    auto index = m_round_robin_cursor.fetch_add(1, std::memory_order_relaxed);
+
+    while (!tasks.empty()) {
+        const auto count = std::min(chunk_size, tasks.size());
+        m_lanes[index++ % lane_count]->enqueue(tasks.subspan(0, count));
+        tasks = tasks.subspan(count);
+    }
+}
+
+int keyed_executor::max_concurrency_level() const noexcept {
+    return static_cast<int>(std::min(m_lanes.size(), static_cast<size_t>(m_underlying_executor->max_concurrency_level())));
+}
+
+bool keyed_executor::shutdown_requested() const {
+    if (m_abort.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    // a lane shuts itself down when the underlying executor can't schedule it anymore,
+    // enqueuing doesn't look for that (the lane itself rejects the task) but the query reports it.
+    return std::any_of(m_lanes.begin(), m_lanes.end(), [](const auto& lane) {
+        return lane->shutdown_requested();
+    });
+}
+
+void keyed_executor::shutdown() {
+    const auto abort = m_abort.exchange(true, std::memory_order_relaxed);
+    if (abort) {
+        return;  // shutdown had been called before.
+    }
+
+    for (auto& lane : m_lanes) {
+        lane->shutdown();
+    }
+}
+
+size_t keyed_executor::lane_count() const noexcept {
+    return m_lanes.size();
+}
+
+std::shared_ptr<strand_executor> keyed_executor::lane(size_t index) const {
+    if (index >= m_lanes.size()) {
+        throw std::invalid_argument(details::consts::k_keyed_executor_invalid_lane_err_msg);
+    }
+
+    return m_lanes[index];
+}
+
+std::shared_ptr<executor> keyed_executor::underlying_executor() const noexcept {
+    return m_underlying_executor;
+}
+
+size_t keyed_executor::queue_depth(size_t lane_index) const {
+    return lane(lane_index)->size();
+}
+
+std::vector<size_t> keyed_executor::queue_depths() const {
+    std::vector<size_t> depths;
+    depths.reserve(m_lanes.size());
+
+    for (const auto& lane : m_lanes) {
+        depths.emplace_back(lane->size());
+    }
+
+    return depths;
+}
@@ -1,12 +1,82 @@
 #include "concurrencpp/executors/constants.h"
 #include "concurrencpp/executors/manual_executor.h"
 
+#include <system_error>
+
+#if defined(CRCPP_UNIX_OS) && defined(__linux__)
+#    include <cerrno>
+#    include <cstdint>
+
+#    include <unistd.h>
+#    include <sys/eventfd.h>
+#endif
+
 using concurrencpp::manual_executor;
 
 manual_executor::manual_executor() :
-    derivable_executor<concurrencpp::manual_executor>(details::consts::k_manual_executor_name), m_abort(false), m_atomic_abort(false) {
+    derivable_executor<concurrencpp::manual_executor>(details::consts::k_manual_executor_name), m_abort(false), m_atomic_abort(false),
+    m_wakeup_fd(-1), m_wakeup_signaled(false) {}
+
+#if defined(CRCPP_UNIX_OS) && defined(__linux__)
+
+manual_executor::~manual_executor() noexcept {
+    if (m_wakeup_fd != -1) {
+        ::close(m_wakeup_fd);
+    }
+}
+
+int manual_executor::wakeup_fd() {
+    std::unique_lock<decltype(m_lock)> lock(m_lock);
+    if (m_wakeup_fd != -1) {
+        return m_wakeup_fd;
+    }
+
+    m_wakeup_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeup_fd == -1) {
+        throw std::system_error(errno, std::system_category());
+    }
+
+    if (!m_tasks.empty() || m_abort) {
+        signal_wakeup_fd();
+    }
+
+    return m_wakeup_fd;
+}
+
+void manual_executor::signal_wakeup_fd() noexcept {
+    if (m_wakeup_fd == -1 || m_wakeup_signaled) {
+        return;
+    }
+
+    const std::uint64_t value = 1;
+    [[maybe_unused]] const auto written = ::write(m_wakeup_fd, &value, sizeof(value));
+    m_wakeup_signaled = true;
+}
+
+void manual_executor::reset_wakeup_fd() noexcept {
+    if (!m_wakeup_signaled) {
+        return;
+    }
+
+    std::uint64_t value;
+    [[maybe_unused]] const auto read = ::read(m_wakeup_fd, &value, sizeof(value));
+    m_wakeup_signaled = false;
+}
+
+#else
+
+manual_executor::~manual_executor() noexcept = default;
+
+int manual_executor::wakeup_fd() {
+    return -1;
 }
 
+void manual_executor::signal_wakeup_fd() noexcept {}
+
+void manual_executor::reset_wakeup_fd() noexcept {}
+
+#endif
+
 void manual_executor::enqueue(concurrencpp::task task) {
     std::unique_lock<decltype(m_lock)> lock(m_lock);
     if (m_abort) {
@@ -14,6 +84,7 @@ void manual_executor::enqueue(concurrencpp::task task) {
     }
 
     m_tasks.emplace_back(std::move(task));
+    signal_wakeup_fd();
     lock.unlock();
 
     m_condition.notify_all();
@@ -26,6 +97,10 @@ void manual_executor::enqueue(std::span<concurrencpp::task> tasks) {
     }
 
     m_tasks.insert(m_tasks.end(), std::make_move_iterator(tasks.begin()), std::make_move_iterator(tasks.end()));
+    if (!m_tasks.empty()) {
+        signal_wakeup_fd();
+    }
+
     lock.unlock();
 
     m_condition.notify_all();
@@ -44,33 +119,78 @@ bool manual_executor::empty() const {
     return size() == 0;
 }
 
+void manual_executor::requeue_batch(std::deque<task>& batch) {
+    std::unique_lock<decltype(m_lock)> lock(m_lock);
+    if (m_abort) {
+        return;
+    }
+
+    m_tasks.insert(m_tasks.begin(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+    if (!m_tasks.empty()) {
+        signal_wakeup_fd();
+    }
+}
+
+void manual_executor::take_batch(std::deque<task>& batch, size_t max_count) {
+    assert(batch.empty());
+
+    if (max_count >= m_tasks.size()) {
+        std::swap(batch, m_tasks);
+    } else {
+        const auto last = m_tasks.begin() + static_cast<std::ptrdiff_t>(max_count);
+        batch.insert(batch.end(), std::make_move_iterator(m_tasks.begin()), std::make_move_iterator(last));
+        m_tasks.erase(m_tasks.begin(), last);
+    }
+
+    if (m_tasks.empty()) {
+        reset_wakeup_fd();
+    }
+}
+
+size_t manual_executor::execute_batch(std::deque<task>& batch) {
+    size_t executed = 0;
+
+    try {
+        while (executed != batch.size()) {
+            if (shutdown_requested()) {
+                break;
+            }
+
+            auto task = std::move(batch[executed]);
+            ++executed;
+            task();
+        }
+    } catch (...) {
+        batch.erase(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(executed));
+        requeue_batch(batch);
+        batch.clear();
+        throw;
+    }
+
+    // tasks left over by a shutdown are dropped
+    return executed;
+}
+
 size_t manual_executor::loop_impl(size_t max_count) {
     if (max_count == 0) {
         return 0;
     }
 
     size_t executed = 0;
+    std::deque<task> batch;
 
-    while (true) {
-        if (executed == max_count) {
-            break;
-        }
-
-        std::unique_lock<decltype(m_lock)> lock(m_lock);
-        if (m_abort) {
-            break;
-        }
+    while (executed != max_count) {
+        {
+            std::unique_lock<decltype(m_lock)> lock(m_lock);
+            if (m_abort || m_tasks.empty()) {
+                break;
+            }
 
-        if (m_tasks.empty()) {
-            break;
+            take_batch(batch, max_count - executed);
         }
 
-        auto task = std::move(m_tasks.front());
-        m_tasks.pop_front();
-        lock.unlock();
-
-        task();
-        ++executed;
+        executed += execute_batch(batch);
+        batch.clear();
     }
 
     if (shutdown_requested()) {
@@ -114,6 +234,10 @@ size_t manual_executor::loop_until_impl(size_t max_count, std::chrono::time_poin
         assert(!m_tasks.empty());
         auto task = std::move(m_tasks.front());
         m_tasks.pop_front();
+        if (m_tasks.empty()) {
+            reset_wakeup_fd();
+        }
+
         lock.unlock();
 
         task();
@@ -197,10 +321,33 @@ size_t manual_executor::clear() {
     }
 
     const auto tasks = std::move(m_tasks);
+    m_tasks.clear();
+    reset_wakeup_fd();
     lock.unlock();
     return tasks.size();
 }
 
+size_t manual_executor::drain() {
+    std::deque<task> batch;
+
+    {
+        std::unique_lock<decltype(m_lock)> lock(m_lock);
+        if (m_abort) {
+            details::throw_runtime_shutdown_exception(name);
+        }
+
+        take_batch(batch, m_tasks.size());
+    }
+
+    const auto executed = execute_batch(batch);
+
+    if (shutdown_requested()) {
+        details::throw_runtime_shutdown_exception(name);
+    }
+
+    return executed;
+}
+
 void manual_executor::wait_for_task() {
     wait_for_tasks_impl(1);
 }
@@ -229,6 +376,9 @@ void manual_executor::shutdown() {
         std::unique_lock<decltype(m_lock)> lock(m_lock);
         m_abort = true;
         tasks = std::move(m_tasks);
+
+        // wakes up a reactor so it can notice the shutdown
+        signal_wakeup_fd();
     }
 
     m_condition.notify_all();
@@ -0,0 +1,184 @@
+#include "concurrencpp/errors.h"
+#include "concurrencpp/executors/constants.h"
+#include "concurrencpp/executors/strand_executor.h"
+#include "concurrencpp/executors/impl/mpsc_task_queue.h"
+
+#include <deque>
+#include <stdexcept>
+
+using concurrencpp::executor;
+using concurrencpp::strand_executor;
+
+struct strand_executor::strand_state : public std::enable_shared_from_this<strand_state> {
+    const std::shared_ptr<executor> underlying_executor;
+    const size_t max_batch_size;
+    details::mpsc_task_queue inbox;
+    std::deque<task> batch;  // only touched by the currently scheduled drain
+    std::atomic_intptr_t pending_count;
+    std::atomic_bool abort;
+
+    strand_state(std::shared_ptr<executor> underlying_executor, size_t max_batch_size) noexcept :
+        underlying_executor(std::move(underlying_executor)), max_batch_size(max_batch_size), pending_count(0), abort(false) {}
+
+    // the underlying executor may accept the drain task and destroy it without running it (e.g. when it is shut down
+    // with the task still queued), in which case the strand is shut down just like when enqueue throws.
+    class drain_task {
+
+       private:
+        std::shared_ptr<strand_state> m_state;
+
+       public:
+        explicit drain_task(std::shared_ptr<strand_state> state) noexcept : m_state(std::move(state)) {}
+
+        drain_task(drain_task&& rhs) noexcept = default;
+
+        ~drain_task() noexcept {
+            if (static_cast<bool>(m_state)) {
+                m_state->on_schedule_failed();
+            }
+        }
+
+        void operator()() {
+            const auto state = std::move(m_state);
+            state->drain();
+        }
+    };
+
+    void schedule() {
+        underlying_executor->enqueue(task(drain_task(shared_from_this())));
+    }
+
+    // nothing will drain the inbox anymore, later enqueues have to throw instead of leaving their tasks in it
+    void on_schedule_failed() noexcept {
+        abort.store(true, std::memory_order_relaxed);
+        inbox.close();
+    }
+
+    void on_pushed(size_t count) {
+        // a producer pushes before it counts, so a drain may execute (and subtract) a task before it is counted
+        // and the counter may be negative for a moment. While a drain is scheduled the counter stays positive,
+        // so whoever moves it from non-positive to positive schedules the strand.
+        const auto previous = pending_count.fetch_add(static_cast<intptr_t>(count), std::memory_order_acq_rel);
+        if (previous <= 0 && previous + static_cast<intptr_t>(count) > 0) {
+            try {
+                schedule();
+            } catch (...) {
+                on_schedule_failed();
+                throw;
+            }
+        }
+    }
+
+    void on_batch_executed(size_t executed) {
+        if (abort.load(std::memory_order_relaxed)) {
+            batch.clear();
+            return;
+        }
+
+        const auto remaining = pending_count.fetch_sub(static_cast<intptr_t>(executed), std::memory_order_acq_rel) -
+            static_cast<intptr_t>(executed);
+        if (remaining <= 0) {
+            return;
+        }
+
+        try {
+            schedule();
+        } catch (const errors::runtime_shutdown&) {
+            // the underlying executor was shut down, the remaining tasks can't run anymore.
+            on_schedule_failed();
+            batch.clear();
+        } catch (...) {
+            on_schedule_failed();
+            batch.clear();
+            throw;
+        }
+    }
+
+    void drain() {
+        size_t executed = 0;
+
+        try {
+            while (executed != max_batch_size && !abort.load(std::memory_order_relaxed)) {
+                if (batch.empty() && inbox.pop_all(batch) == 0) {
+                    break;
+                }
+
+                auto task = std::move(batch.front());
+                batch.pop_front();
+                ++executed;
+                task();
+            }
+        } catch (...) {
+            on_batch_executed(executed);
+            throw;
+        }
+
+        on_batch_executed(executed);
+    }
+};
+
+strand_executor::strand_executor(std::shared_ptr<executor> underlying_executor, size_t max_batch_size) :
+    derivable_executor<concurrencpp::strand_executor>(details::consts::k_strand_executor_name),
+    m_state([&] {
+        if (!static_cast<bool>(underlying_executor)) {
+            throw std::invalid_argument(details::consts::k_strand_executor_null_executor_err_msg);
+        }
+
+        if (max_batch_size == 0) {
+            throw std::invalid_argument(details::consts::k_strand_executor_invalid_batch_size_err_msg);
+        }
+
+        return std::make_shared<strand_state>(std::move(underlying_executor), max_batch_size);
+    }()) {}
+
+void strand_executor::enqueue(concurrencpp::task task) {
+    const auto status = m_state->inbox.push(task);
+    if (status == details::mpsc_push_status::closed) {
+        details::throw_runtime_shutdown_exception(name);
+    }
+
+    m_state->on_pushed(1);
+}
+
+void strand_executor::enqueue(std::span<concurrencpp::task> tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    const auto status = m_state->inbox.push(tasks);
+    if (status == details::mpsc_push_status::closed) {
+        details::throw_runtime_shutdown_exception(name);
+    }
+
+    m_state->on_pushed(tasks.size());
+}
+
+int strand_executor::max_concurrency_level() const noexcept {
+    return details::consts::k_strand_executor_max_concurrency_level;
+}
+
+bool strand_executor::shutdown_requested() const {
+    return m_state->abort.load(std::memory_order_relaxed);
+}
+
+void strand_executor::shutdown() {
+    const auto abort = m_state->abort.exchange(true, std::memory_order_relaxed);
+    if (abort) {
+        return;  // shutdown had been called before.
+    }
+
+    m_state->inbox.close();
+}
+
+std::shared_ptr<executor> strand_executor::underlying_executor() const noexcept {
+    return m_state->underlying_executor;
+}
+
+size_t strand_executor::max_batch_size() const noexcept {
+    return m_state->max_batch_size;
+}
+
+size_t strand_executor::size() const noexcept {
+    const auto pending_count = m_state->pending_count.load(std::memory_order_relaxed);
+    return (pending_count > 0) ? static_cast<size_t>(pending_count) : 0;
+}
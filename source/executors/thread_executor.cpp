@@ -1,26 +1,84 @@
 #include "concurrencpp/executors/constants.h"
 #include "concurrencpp/executors/thread_executor.h"
 
+#include <algorithm>
+
 using concurrencpp::thread_executor;
 
-thread_executor::thread_executor() :
-    derivable_executor<concurrencpp::thread_executor>(details::consts::k_thread_executor_name), m_abort(false), m_atomic_abort(false) {
-}
+thread_executor::thread_executor(const executor_thread_options& thread_options,
+                                 size_t max_cached_threads,
+                                 std::chrono::milliseconds max_cached_thread_idle_time) :
+    derivable_executor<concurrencpp::thread_executor>(details::consts::k_thread_executor_name), m_abort(false), m_atomic_abort(false),
+    m_thread_options(thread_options), m_max_cached_threads(max_cached_threads),
+    m_max_cached_thread_idle_time(max_cached_thread_idle_time) {}
 
 thread_executor::~thread_executor() noexcept {
     assert(m_workers.empty());
+    assert(m_parked_workers.empty());
     assert(m_last_retired.empty());
 }
 
 void thread_executor::enqueue_impl(std::unique_lock<std::mutex>& lock, concurrencpp::task& task) {
     assert(lock.owns_lock());
 
-    auto& new_thread = m_workers.emplace_front();
-    new_thread = details::thread(details::make_executor_worker_name(name),
-                                 [this, self_it = m_workers.begin(), task = std::move(task)]() mutable {
-                                     task();
-                                     retire_worker(self_it);
-                                 });
+    // a parked thread is dedicated to the task just like a new one would be
+    if (m_max_cached_threads != 0 && !m_parked_workers.empty()) {
+        const auto parked_worker = m_parked_workers.back();  // the most recently parked one, its stack is still warm
+        m_parked_workers.pop_back();
+
+        parked_worker->next_task = std::move(task);
+        parked_worker->condition.notify_one();
+        return;
+    }
+
+    auto& new_worker = m_workers.emplace_front();
+    new_worker.thread = details::thread(
+        details::make_executor_worker_name(name),
+        [this, self_it = m_workers.begin(), task = std::move(task)]() mutable {
+            work_loop(self_it, task);
+        },
+        &m_thread_options);
+}
+
+void thread_executor::work_loop(worker_iterator self_it, concurrencpp::task& task) {
+    do {
+        task();
+    } while (wait_for_task(self_it, task));
+
+    retire_worker(self_it);
+}
+
+bool thread_executor::wait_for_task(worker_iterator self_it, concurrencpp::task& task) {
+    if (m_max_cached_threads == 0) {
+        return false;  // the default, threads are not cached and retire right away
+    }
+
+    // running a task already destroys its callable, make sure nothing is left to be destroyed under m_lock:
+    // a callable's destructor may enqueue into this executor
+    task.clear();
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (m_abort || m_parked_workers.size() >= m_max_cached_threads) {
+        return false;
+    }
+
+    m_parked_workers.emplace_back(self_it);
+
+    self_it->condition.wait_for(lock, m_max_cached_thread_idle_time, [this, self_it] {
+        return static_cast<bool>(self_it->next_task) || m_abort;
+    });
+
+    if (self_it->next_task) {
+        // enqueue has already taken us off the parked list
+        task = std::move(self_it->next_task);
+        return true;
+    }
+
+    // timed out or shut down
+    const auto parked_it = std::find(m_parked_workers.begin(), m_parked_workers.end(), self_it);
+    assert(parked_it != m_parked_workers.end());
+    m_parked_workers.erase(parked_it);
+    return false;
 }
 
 void thread_executor::enqueue(concurrencpp::task task) {
@@ -59,6 +117,11 @@ void thread_executor::shutdown() {
 
     std::unique_lock<std::mutex> lock(m_lock);
     m_abort = true;
+
+    for (const auto parked_worker : m_parked_workers) {
+        parked_worker->condition.notify_one();
+    }
+
     m_condition.wait(lock, [this] {
         return m_workers.empty();
     });
@@ -68,11 +131,11 @@ void thread_executor::shutdown() {
     }
 
     assert(m_last_retired.size() == 1);
-    m_last_retired.front().join();
+    m_last_retired.front().thread.join();
     m_last_retired.clear();
 }
 
-void thread_executor::retire_worker(std::list<details::thread>::iterator it) {
+void thread_executor::retire_worker(worker_iterator it) {
     std::unique_lock<std::mutex> lock(m_lock);
     auto last_retired = std::move(m_last_retired);
     m_last_retired.splice(m_last_retired.begin(), m_workers, it);
@@ -85,5 +148,13 @@ void thread_executor::retire_worker(std::list<details::thread>::iterator it) {
     }
 
     assert(last_retired.size() == 1);
-    last_retired.front().join();
+    last_retired.front().thread.join();
+}
+
+size_t thread_executor::max_cached_threads() const noexcept {
+    return m_max_cached_threads;
+}
+
+std::chrono::milliseconds thread_executor::max_cached_thread_idle_time() const noexcept {
+    return m_max_cached_thread_idle_time;
 }
\ No newline at end of file
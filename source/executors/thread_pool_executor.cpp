@@ -1,10 +1,21 @@
+#include "concurrencpp/errors.h"
+#include "concurrencpp/executors/constants.h"
+#include "concurrencpp/threads/cpu_relax.h"
+#include "concurrencpp/threads/numa_topology.h"
 #include "concurrencpp/executors/thread_pool_executor.h"
 
+#include <bit>
+#include <thread>
 #include <algorithm>
+#include <stdexcept>
 
+using concurrencpp::blocking_region;
 using concurrencpp::thread_pool_executor;
+using concurrencpp::thread_pool_executor_options;
 using concurrencpp::details::idle_worker_set;
+using concurrencpp::details::mpsc_push_status;
 using concurrencpp::details::thread_pool_worker;
+using concurrencpp::details::thread_pool_numa_partition;
 
 namespace concurrencpp::details {
     struct thread_pool_per_thread_data {
@@ -25,104 +36,394 @@ namespace concurrencpp::details {
     static thread_local thread_pool_per_thread_data s_tl_thread_pool_data;
 }  // namespace concurrencpp::details
 
-idle_worker_set::idle_worker_set(size_t size) : m_approx_size(0), m_idle_flags(std::make_unique<padded_flag[]>(size)), m_size(size) {}
+namespace concurrencpp::details {
+    namespace {
+        std::vector<thread_pool_numa_partition> make_numa_partitions(size_t pool_size, const thread_pool_executor_options& options) {
+            if (!options.numa_aware || pool_size == 0) {
+                return {};
+            }
+
+            const auto& topology = numa_topology::system();
+            std::vector<const numa_node*> nodes;
+
+            if (options.numa_nodes.empty()) {
+                for (const auto& node : topology.nodes()) {
+                    nodes.emplace_back(&node);
+                }
+            } else {
+                for (const auto node_id : options.numa_nodes) {
+                    const auto node_index = topology.index_of_node(node_id);
+                    if (node_index == static_cast<size_t>(-1)) {
+                        throw std::invalid_argument(consts::k_thread_pool_executor_unknown_numa_node_err_msg);
+                    }
+
+                    nodes.emplace_back(&topology.nodes()[node_index]);
+                }
+            }
+
+            // workers can only be pinned to the cpus both their node and the pool's cpu affinity allow
+            const auto& cpu_affinity = options.thread_options.cpu_affinity;
+            std::vector<std::vector<size_t>> node_cpus;
+            node_cpus.reserve(nodes.size());
+
+            for (const auto node : nodes) {
+                auto& cpus = node_cpus.emplace_back();
+                for (const auto cpu : node->cpus) {
+                    if (cpu_affinity.empty() || std::find(cpu_affinity.begin(), cpu_affinity.end(), cpu) != cpu_affinity.end()) {
+                        cpus.emplace_back(cpu);
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < nodes.size();) {
+                if (!node_cpus[i].empty()) {
+                    ++i;
+                    continue;
+                }
+
+                nodes.erase(nodes.begin() + i);
+                node_cpus.erase(node_cpus.begin() + i);
+            }
+
+            if (nodes.empty()) {
+                throw std::invalid_argument(consts::k_thread_pool_executor_numa_affinity_mismatch_err_msg);
+            }
+
+            // workers are spread across the nodes in proportion to their cpu count
+            size_t total_cpus = 0;
+            for (const auto& cpus : node_cpus) {
+                total_cpus += cpus.size();
+            }
+
+            std::vector<size_t> worker_counts(nodes.size());
+            size_t assigned = 0;
+            for (size_t i = 0; i < nodes.size(); i++) {
+                worker_counts[i] = pool_size * node_cpus[i].size() / total_cpus;
+                assigned += worker_counts[i];
+            }
+
+            for (size_t i = 0; assigned < pool_size; i = (i + 1) % nodes.size()) {
+                ++worker_counts[i];
+                ++assigned;
+            }
+
+            std::vector<thread_pool_numa_partition> partitions;
+            size_t begin = 0;
+            for (size_t i = 0; i < nodes.size(); i++) {
+                if (worker_counts[i] == 0) {
+                    continue;
+                }
+
+                partitions.emplace_back(
+                    thread_pool_numa_partition {nodes[i]->id, begin, begin + worker_counts[i], std::move(node_cpus[i])});
+                begin += worker_counts[i];
+            }
+
+            return partitions;
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+thread_pool_executor_options::thread_pool_executor_options() noexcept :
+    work_stealing(details::consts::k_thread_pool_default_work_stealing),
+    idle_spin_time(details::consts::k_thread_pool_default_idle_spin_time),
+    idle_yield_time(details::consts::k_thread_pool_default_idle_yield_time),
+    adaptive_idle_spinning(details::consts::k_thread_pool_default_adaptive_idle_spinning),
+    prewarm_workers(details::consts::k_thread_pool_default_prewarm_workers),
+    min_alive_workers(details::consts::k_thread_pool_default_min_alive_workers),
+    retirement_idle_periods(details::consts::k_thread_pool_default_retirement_idle_periods),
+    staggered_retirement(details::consts::k_thread_pool_default_staggered_retirement),
+    priority_starvation_limit(details::consts::k_thread_pool_default_priority_starvation_limit),
+    next_task_slot(details::consts::k_thread_pool_default_next_task_slot),
+    next_task_slot_limit(details::consts::k_thread_pool_default_next_task_slot_limit),
+    max_compensation_workers(details::consts::k_thread_pool_default_max_compensation_workers),
+    numa_aware(details::consts::k_thread_pool_default_numa_aware) {}
+
+namespace concurrencpp::details {
+    namespace {
+        constexpr size_t k_bits_per_word = 64;
+
+        std::uint64_t bit_of(size_t index) noexcept {
+            return std::uint64_t(1) << (index % k_bits_per_word);
+        }
+
+        size_t word_count_of(size_t bit_count) noexcept {
+            return (bit_count + k_bits_per_word - 1) / k_bits_per_word;
+        }
+
+        static_assert(static_cast<size_t>(concurrencpp::task_priority::high) == 0);
+        static_assert(static_cast<size_t>(concurrencpp::task_priority::low) == consts::k_thread_pool_priority_count - 1);
+
+        size_t lane_of(concurrencpp::task_priority priority) {
+            const auto lane = static_cast<size_t>(priority);
+            if (lane >= consts::k_thread_pool_priority_count) {
+                throw std::invalid_argument(consts::k_thread_pool_executor_invalid_priority_err_msg);
+            }
+
+            return lane;
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+idle_worker_set::idle_worker_set(size_t size) :
+    m_approx_size(0), m_size(size), m_word_count(word_count_of(size)), m_idle_words(std::make_unique<padded_word[]>(m_word_count)),
+    m_summary_words(std::make_unique<padded_word[]>(word_count_of(m_word_count))) {}
+
+size_t idle_worker_set::approx_size() const noexcept {
+    const auto approx_size = m_approx_size.load(std::memory_order_relaxed);
+    return (approx_size > 0) ? static_cast<size_t>(approx_size) : 0;
+}
+
+void idle_worker_set::set_summary_bit(size_t word_index) noexcept {
+    auto& summary = m_summary_words[word_index / k_bits_per_word].bits;
+    const auto bit = bit_of(word_index);
+
+    if ((summary.load(std::memory_order_seq_cst) & bit) == 0) {
+        summary.fetch_or(bit, std::memory_order_seq_cst);
+    }
+}
+
+void idle_worker_set::clear_summary_bit(size_t word_index) noexcept {
+    auto& summary = m_summary_words[word_index / k_bits_per_word].bits;
+    const auto bit = bit_of(word_index);
+
+    summary.fetch_and(~bit, std::memory_order_seq_cst);
+
+    // a worker might have become idle in the meantime, its summary bit must not get lost.
+    if (m_idle_words[word_index].bits.load(std::memory_order_seq_cst) != 0) {
+        summary.fetch_or(bit, std::memory_order_seq_cst);
+    }
+}
 
 void idle_worker_set::set_idle(size_t idle_thread) noexcept {
-    const auto before = m_idle_flags[idle_thread].flag.exchange(status::idle, std::memory_order_relaxed);
-    if (before == status::idle) {
+    const auto word_index = idle_thread / k_bits_per_word;
+    const auto bit = bit_of(idle_thread);
+
+    const auto before = m_idle_words[word_index].bits.fetch_or(bit, std::memory_order_seq_cst);
+    if ((before & bit) != 0) {
         return;
     }
 
     m_approx_size.fetch_add(1, std::memory_order_relaxed);
+    set_summary_bit(word_index);
 }
 
 void idle_worker_set::set_active(size_t idle_thread) noexcept {
-    const auto before = m_idle_flags[idle_thread].flag.exchange(status::active, std::memory_order_relaxed);
-    if (before == status::active) {
+    const auto word_index = idle_thread / k_bits_per_word;
+    const auto bit = bit_of(idle_thread);
+
+    const auto before = m_idle_words[word_index].bits.fetch_and(~bit, std::memory_order_seq_cst);
+    if ((before & bit) == 0) {
         return;
     }
 
     m_approx_size.fetch_sub(1, std::memory_order_relaxed);
-}
 
-bool idle_worker_set::try_acquire_flag(size_t index) noexcept {
-    const auto worker_status = m_idle_flags[index].flag.load(std::memory_order_relaxed);
-    if (worker_status == status::active) {
-        return false;
+    if ((before & ~bit) == 0) {
+        clear_summary_bit(word_index);
     }
+}
+
+std::uint64_t idle_worker_set::acquire_bits(size_t word_index, std::uint64_t mask, size_t max_count) noexcept {
+    assert(max_count != 0);
+
+    auto& word = m_idle_words[word_index].bits;
+    auto available = word.load(std::memory_order_relaxed) & mask;
+
+    while (available != 0) {
+        auto wanted = available;
+        if (static_cast<size_t>(std::popcount(wanted)) > max_count) {
+            wanted = 0;
+            for (size_t i = 0; i < max_count; i++) {
+                wanted |= available & (~available + 1);  // lowest set bit
+                available &= available - 1;
+            }
+        }
+
+        const auto before = word.fetch_and(~wanted, std::memory_order_seq_cst);
+        const auto acquired = before & wanted;
+
+        if (acquired != 0) {
+            m_approx_size.fetch_sub(std::popcount(acquired), std::memory_order_relaxed);
+
+            if ((before & ~wanted) == 0) {
+                clear_summary_bit(word_index);
+            }
+
+            return acquired;
+        }
 
-    const auto before = m_idle_flags[index].flag.exchange(status::active, std::memory_order_relaxed);
-    const auto swapped = (before == status::idle);
-    if (swapped) {
-        m_approx_size.fetch_sub(1, std::memory_order_relaxed);
+        available = before & mask;  // other enqueuers got there first, try the rest.
     }
 
-    return swapped;
+    return 0;
 }
 
-size_t idle_worker_set::find_idle_worker(size_t caller_index) noexcept {
-    if (m_approx_size.load(std::memory_order_relaxed) <= 0) {
-        return static_cast<size_t>(-1);
+template<class visitor_type>
+void idle_worker_set::visit_idle_words(size_t range_begin,
+                                       size_t range_end,
+                                       size_t starting_pos,
+                                       size_t caller_index,
+                                       visitor_type&& visitor) noexcept {
+    assert(range_begin <= starting_pos && starting_pos < range_end && range_end <= m_size);
+
+    const auto first_word = range_begin / k_bits_per_word;
+    const auto last_word = (range_end - 1) / k_bits_per_word;
+    const auto word_span = last_word - first_word + 1;
+    const auto start_word = starting_pos / k_bits_per_word;
+    const auto start_mask = ~std::uint64_t(0) << (starting_pos % k_bits_per_word);
+
+    const auto mask_of = [=](size_t word_index, std::uint64_t mask) {
+        if (word_index == first_word) {
+            mask &= ~std::uint64_t(0) << (range_begin % k_bits_per_word);
+        }
+
+        const auto end_bit = range_end - last_word * k_bits_per_word;
+        if (word_index == last_word && end_bit < k_bits_per_word) {
+            mask &= (std::uint64_t(1) << end_bit) - 1;
+        }
+
+        if (caller_index / k_bits_per_word == word_index) {
+            mask &= ~bit_of(caller_index);
+        }
+
+        return mask;
+    };
+
+    if (visitor(start_word, mask_of(start_word, start_mask))) {
+        return;
     }
 
-    const auto starting_pos =
-        (caller_index != static_cast<size_t>(-1)) ? caller_index : (s_tl_thread_pool_data.this_thread_hashed_id % m_size);
+    // the rest of the words in a circular order, words the summary marks as empty are skipped.
+    for (size_t step = 1; step < word_span;) {
+        const auto word_index = first_word + (start_word - first_word + step) % word_span;
+        const auto bit_index = word_index % k_bits_per_word;
+        const auto summary = m_summary_words[word_index / k_bits_per_word].bits.load(std::memory_order_seq_cst) >> bit_index;
+        const auto words_left = last_word + 1 - word_index;
+
+        if (summary == 0) {
+            step += std::min(k_bits_per_word - bit_index, words_left);
+            continue;
+        }
 
-    for (size_t i = 0; i < m_size; i++) {
-        const auto index = (starting_pos + i) % m_size;
-        if (index == caller_index) {
+        const auto offset = static_cast<size_t>(std::countr_zero(summary));
+        if (offset >= words_left) {
+            step += words_left;  // past the end of the range, wrap around
             continue;
         }
 
-        if (try_acquire_flag(index)) {
-            return index;
+        step += offset;
+        if (step >= word_span) {
+            break;  // wrapped around to the starting word
+        }
+
+        if (visitor(word_index + offset, mask_of(word_index + offset, ~std::uint64_t(0)))) {
+            return;
         }
+
+        ++step;
+    }
+
+    if (start_mask != ~std::uint64_t(0)) {
+        visitor(start_word, mask_of(start_word, ~start_mask));
+    }
+}
+
+size_t idle_worker_set::find_idle_worker(size_t caller_index) noexcept {
+    return find_idle_worker(caller_index, 0, m_size);
+}
+
+size_t idle_worker_set::find_idle_worker(size_t caller_index, size_t range_begin, size_t range_end) noexcept {
+    if (m_approx_size.load(std::memory_order_relaxed) <= 0 || range_begin == range_end) {
+        return static_cast<size_t>(-1);
     }
 
-    return static_cast<size_t>(-1);
+    const auto starting_pos = (caller_index >= range_begin && caller_index < range_end) ?
+        caller_index :
+        range_begin + (s_tl_thread_pool_data.this_thread_hashed_id % (range_end - range_begin));
+
+    auto idle_worker = static_cast<size_t>(-1);
+    visit_idle_words(range_begin, range_end, starting_pos, caller_index, [this, &idle_worker](size_t word_index, std::uint64_t mask) {
+        const auto acquired = acquire_bits(word_index, mask, 1);
+        if (acquired == 0) {
+            return false;
+        }
+
+        idle_worker = word_index * k_bits_per_word + static_cast<size_t>(std::countr_zero(acquired));
+        return true;
+    });
+
+    return idle_worker;
 }
 
 void idle_worker_set::find_idle_workers(size_t caller_index, std::vector<size_t>& result_buffer, size_t max_count) noexcept {
-    assert(result_buffer.capacity() >= max_count);
+    find_idle_workers(caller_index, result_buffer, max_count, 0, m_size);
+}
+
+void idle_worker_set::find_idle_workers(size_t caller_index,
+                                        std::vector<size_t>& result_buffer,
+                                        size_t max_count,
+                                        size_t range_begin,
+                                        size_t range_end) noexcept {
+    assert(result_buffer.capacity() >= result_buffer.size() + max_count);
 
     const auto approx_size = m_approx_size.load(std::memory_order_relaxed);
-    if (approx_size <= 0) {
+    if (approx_size <= 0 || max_count == 0 || range_begin == range_end) {
         return;
     }
 
-    assert(caller_index < m_size);
-    assert(caller_index == s_tl_thread_pool_data.this_thread_index);
+    assert(caller_index < m_size || caller_index == static_cast<size_t>(-1));
+    assert(caller_index == s_tl_thread_pool_data.this_thread_index || caller_index == static_cast<size_t>(-1));
 
     size_t count = 0;
     const auto max_waiters = std::min(static_cast<size_t>(approx_size), max_count);
+    const auto starting_pos = (caller_index >= range_begin && caller_index < range_end) ?
+        caller_index :
+        range_begin + (s_tl_thread_pool_data.this_thread_hashed_id % (range_end - range_begin));
 
-    for (size_t i = 0; (i < m_size) && (count < max_waiters); i++) {
-        const auto index = (caller_index + i) % m_size;
-        if (index == caller_index) {
-            continue;
-        }
+    visit_idle_words(range_begin, range_end, starting_pos, caller_index, [&](size_t word_index, std::uint64_t mask) {
+        auto acquired = acquire_bits(word_index, mask, max_waiters - count);
 
-        if (try_acquire_flag(index)) {
-            result_buffer.emplace_back(index);
+        for (; acquired != 0; acquired &= acquired - 1) {
+            result_buffer.emplace_back(word_index * k_bits_per_word + static_cast<size_t>(std::countr_zero(acquired)));
             ++count;
         }
-    }
+
+        return count == max_waiters;
+    });
 }
 
 thread_pool_worker::thread_pool_worker(thread_pool_executor& parent_pool,
                                        size_t index,
                                        size_t pool_size,
-                                       std::chrono::milliseconds max_idle_time) :
-    m_atomic_abort(false),
-    m_parent_pool(parent_pool), m_index(index), m_pool_size(pool_size), m_max_idle_time(max_idle_time),
-    m_worker_name(details::make_executor_worker_name(parent_pool.name)), m_semaphore(0), m_idle(true), m_abort(false),
-    m_task_found_or_abort(false) {
+                                       std::chrono::milliseconds max_idle_time,
+                                       const thread_pool_numa_partition* numa_partition,
+                                       bool compensation_slot) :
+    m_private_queues {consts::k_thread_pool_worker_initial_priority_queue_capacity,
+                      consts::k_thread_pool_worker_initial_queue_capacity,
+                      consts::k_thread_pool_worker_initial_priority_queue_capacity},
+    m_starvation_counts {}, m_next_task_streak(0), m_searching(false), m_queue_relocated(false), m_numa_partition(numa_partition),
+    m_atomic_abort(false), m_parent_pool(parent_pool), m_index(index), m_pool_size(pool_size), m_max_idle_time(max_idle_time),
+    m_keep_alive(!compensation_slot && index < parent_pool.m_options.min_alive_workers), m_compensation_slot(compensation_slot),
+    m_compensating(false), m_blocked(false), m_worker_name(details::make_executor_worker_name(parent_pool.name)),
+    m_public_task_count(0), m_semaphore(0), m_idle(true), m_abort(false), m_steal_requested(false), m_task_found_or_abort(false) {
+    // start optimistic, the estimate converges to the real inter-arrival time of tasks.
+    const auto& options = parent_pool.m_options;
+    const std::chrono::nanoseconds max_spin_budget = options.idle_spin_time + options.idle_yield_time;
+    m_idle_time_estimate = max_spin_budget / consts::k_thread_pool_adaptive_spin_factor;
+
     m_idle_worker_list.reserve(pool_size);
+
+    static_assert(k_next_task_lane == static_cast<size_t>(concurrencpp::task_priority::normal));
 }
 
 thread_pool_worker::thread_pool_worker(thread_pool_worker&& rhs) noexcept :
-    m_parent_pool(rhs.m_parent_pool), m_index(rhs.m_index), m_pool_size(rhs.m_pool_size), m_max_idle_time(rhs.m_max_idle_time),
-    m_semaphore(0), m_idle(true), m_abort(true) {
+    m_private_queues {consts::k_thread_pool_worker_initial_priority_queue_capacity,
+                      consts::k_thread_pool_worker_initial_queue_capacity,
+                      consts::k_thread_pool_worker_initial_priority_queue_capacity},
+    m_numa_partition(rhs.m_numa_partition), m_parent_pool(rhs.m_parent_pool), m_index(rhs.m_index), m_pool_size(rhs.m_pool_size),
+    m_max_idle_time(rhs.m_max_idle_time), m_keep_alive(rhs.m_keep_alive),
+    m_compensation_slot(rhs.m_compensation_slot), m_semaphore(0), m_idle(true), m_abort(true) {
     std::abort();  // shouldn't be called
 }
 
@@ -132,7 +433,19 @@ thread_pool_worker::~thread_pool_worker() noexcept {
 }
 
 void thread_pool_worker::balance_work() {
-    const auto task_count = m_private_queue.size();
+    if (!m_parent_pool.m_options.work_stealing) {
+        return donate_work();
+    }
+
+    if (private_task_count() < 2) {  // no point in waking a thief
+        return;
+    }
+
+    m_parent_pool.wake_thief(m_index);
+}
+
+void thread_pool_worker::donate_work() {
+    const auto task_count = private_task_count();
     if (task_count < 2) {  // no point in donating tasks
         return;
     }
@@ -154,107 +467,320 @@ void thread_pool_worker::balance_work() {
     const auto donation_count = task_count / total_worker_count;
     auto extra = task_count - donation_count * total_worker_count;
 
-    size_t begin = 0;
-    size_t end = donation_count;
-
     for (const auto idle_worker_index : m_idle_worker_list) {
         assert(idle_worker_index != m_index);
         assert(idle_worker_index < m_pool_size);
-        assert(begin < task_count);
 
+        auto count = donation_count;
         if (extra != 0) {
-            end++;
+            count++;
             extra--;
         }
 
-        assert(end <= task_count);
+        // donate the oldest tasks, the newest ones are the hottest in our cache.
+        // donated tasks keep their priority.
+        auto donated = false;
+        for (size_t i = 0; i < count; i++) {
+            concurrencpp::task task;
+            size_t lane = 0;
+            if (!steal_from_lanes(task, lane)) {
+                break;
+            }
+
+            m_donation_buffers[lane].emplace_back(std::move(task));
+            donated = true;
+        }
+
+        if (!donated) {
+            m_parent_pool.mark_worker_idle(idle_worker_index);
+            continue;
+        }
+
+        auto& idle_worker = m_parent_pool.worker_at(idle_worker_index);
+        for (size_t lane = 0; lane < k_lane_count; lane++) {
+            auto& donation_buffer = m_donation_buffers[lane];
+            if (donation_buffer.empty()) {
+                continue;
+            }
+
+            idle_worker.enqueue_foreign(donation_buffer, lane);
+            donation_buffer.clear();
+        }
+    }
+
+    assert(private_task_count() != 0);
+
+    m_idle_worker_list.clear();
+}
+
+bool thread_pool_worker::steal_task(concurrencpp::task& task) {
+    if (!m_parent_pool.m_options.work_stealing || m_pool_size == 1) {
+        return false;
+    }
+
+    if (!std::exchange(m_searching, false)) {
+        m_parent_pool.begin_searching();
+    }
+
+    const auto found = m_parent_pool.steal_task(m_index, task);
+    m_parent_pool.end_searching();
+    return found;
+}
 
-        auto donation_begin_it = m_private_queue.begin() + begin;
-        auto donation_end_it = m_private_queue.begin() + end;
+size_t thread_pool_worker::private_task_count() const noexcept {
+    size_t count = 0;
+    for (const auto& private_queue : m_private_queues) {
+        count += private_queue.size();
+    }
 
-        assert(donation_begin_it < m_private_queue.end());
-        assert(donation_end_it <= m_private_queue.end());
+    return count;
+}
 
-        m_parent_pool.worker_at(idle_worker_index).enqueue_foreign(donation_begin_it, donation_end_it);
+void thread_pool_worker::on_lane_served(size_t lane) noexcept {
+    m_starvation_counts[lane] = 0;
+    for (auto lower_lane = lane + 1; lower_lane < k_lane_count; lower_lane++) {
+        if (m_private_queues[lower_lane].empty()) {
+            m_starvation_counts[lower_lane] = 0;
+        } else {
+            ++m_starvation_counts[lower_lane];
+        }
+    }
+}
 
-        begin = end;
-        end += donation_count;
+bool thread_pool_worker::pop_from_lane(size_t lane, concurrencpp::task& task) noexcept {
+    // only we push, a lane that looks empty to us is empty.
+    if (m_private_queues[lane].empty() || !m_private_queues[lane].pop(task)) {
+        return false;
     }
 
-    assert(m_private_queue.size() == task_count);
+    m_next_task_streak = 0;
+    on_lane_served(lane);
+    return true;
+}
 
-    // clear everything we've donated.
-    assert(std::all_of(m_private_queue.begin(), m_private_queue.begin() + begin, [](auto& task) {
-        return !static_cast<bool>(task);
-    }));
+bool thread_pool_worker::pop_next_task(concurrencpp::task& task) noexcept {
+    if (!m_next_task) {
+        return false;
+    }
 
-    assert(std::all_of(m_private_queue.begin() + begin, m_private_queue.end(), [](auto& task) {
-        return static_cast<bool>(task);
-    }));
+    // after <<next_task_slot_limit>> slot tasks in a row, a queued task goes first
+    const auto streak_limit = m_parent_pool.m_options.next_task_slot_limit;
+    if (streak_limit != 0 && m_next_task_streak >= streak_limit && private_task_count() != 0) {
+        return false;
+    }
 
-    m_private_queue.erase(m_private_queue.begin(), m_private_queue.begin() + begin);
+    ++m_next_task_streak;
+    task = std::move(m_next_task);
+    on_lane_served(k_next_task_lane);
+    return true;
+}
 
-    assert(!m_private_queue.empty());
+bool thread_pool_worker::pop_task(concurrencpp::task& task) noexcept {
+    const auto starvation_limit = m_parent_pool.m_options.priority_starvation_limit;
 
-    m_idle_worker_list.clear();
+    // a lane that was passed over too many times goes first
+    if (starvation_limit != 0) {
+        for (size_t lane = 1; lane < k_lane_count; lane++) {
+            if (m_starvation_counts[lane] >= starvation_limit && pop_from_lane(lane, task)) {
+                return true;
+            }
+        }
+    }
+
+    for (size_t lane = 0; lane < k_lane_count; lane++) {
+        if (lane == k_next_task_lane && pop_next_task(task)) {
+            return true;
+        }
+
+        if (pop_from_lane(lane, task)) {
+            return true;
+        }
+    }
+
+    // the queued tasks the slot gave way to might have been stolen in the meantime
+    if (!m_next_task) {
+        return false;
+    }
+
+    m_next_task_streak = 1;
+    task = std::move(m_next_task);
+    on_lane_served(k_next_task_lane);
+    return true;
+}
+
+bool thread_pool_worker::steal_from_lanes(concurrencpp::task& task, size_t& lane) noexcept {
+    for (size_t i = 0; i < k_lane_count; i++) {
+        if (!m_private_queues[i].empty() && m_private_queues[i].steal(task)) {
+            lane = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool thread_pool_worker::has_pending_event() const noexcept {
+    return m_task_found_or_abort.load(std::memory_order_relaxed) || !m_public_queue.empty();
+}
+
+std::chrono::nanoseconds thread_pool_worker::idle_spin_budget() const noexcept {
+    const auto& options = m_parent_pool.m_options;
+    const std::chrono::nanoseconds max_budget = options.idle_spin_time + options.idle_yield_time;
+
+    if (!options.adaptive_idle_spinning) {
+        return max_budget;
+    }
+
+    // tasks usually arrive later than we're willing to spin, parking right away is cheaper.
+    if (m_idle_time_estimate > max_budget) {
+        return std::chrono::nanoseconds(0);
+    }
+
+    return std::min(max_budget, m_idle_time_estimate * consts::k_thread_pool_adaptive_spin_factor);
+}
+
+void thread_pool_worker::record_idle_time(std::chrono::nanoseconds idle_time) noexcept {
+    if (!m_parent_pool.m_options.adaptive_idle_spinning) {
+        return;
+    }
+
+    // exponential moving average of how long it takes for the next task to arrive
+    m_idle_time_estimate += (idle_time - m_idle_time_estimate) / consts::k_thread_pool_idle_time_smoothing_factor;
+}
+
+bool thread_pool_worker::spin_for_event() const noexcept {
+    const auto budget = idle_spin_budget();
+    if (budget <= std::chrono::nanoseconds(0)) {
+        return false;
+    }
+
+    const auto spin_start = std::chrono::steady_clock::now();
+    const auto yield_start = spin_start + std::min<std::chrono::nanoseconds>(budget, m_parent_pool.m_options.idle_spin_time);
+    const auto spin_deadline = spin_start + budget;
+
+    while (true) {
+        if (has_pending_event()) {
+            return true;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= spin_deadline) {
+            return false;
+        }
+
+        if (now < yield_start) {
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
 }
 
 bool thread_pool_worker::wait_for_task(std::unique_lock<std::mutex>& lock) {
     assert(lock.owns_lock());
 
-    if (!m_public_queue.empty() || m_abort) {
+    if (!m_public_queue.empty() || m_abort || m_steal_requested) {
         return true;
     }
 
+    if (dormant()) {
+        m_parent_pool.m_retired_thread_count.fetch_add(1, std::memory_order_relaxed);
+        m_idle = true;
+        lock.unlock();
+        return false;
+    }
+
     lock.unlock();
 
     m_parent_pool.mark_worker_idle(m_index);
 
+    const auto idle_start = std::chrono::steady_clock::now();
+    auto deadline = idle_start + m_max_idle_time;
     auto event_found = false;
-    const auto deadline = std::chrono::steady_clock::now() + m_max_idle_time;
+    size_t idle_periods = 0;
 
-    while (true) {
+    if (spin_for_event()) {
+        lock.lock();
+        event_found = !m_public_queue.empty() || m_abort || m_steal_requested;
+        if (!event_found) {
+            lock.unlock();
+        }
+    }
+
+    while (!event_found) {
         if (!m_semaphore.try_acquire_until(deadline)) {
-            if (std::chrono::steady_clock::now() <= deadline) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now <= deadline) {
                 continue;  // handle spurious wake-ups
-            } else {
+            }
+
+            // kept-alive workers never exit, surplus workers exit after sustained idleness
+            deadline = now + m_max_idle_time;
+            if (dormant()) {
                 break;
             }
+
+            if (m_keep_alive || ++idle_periods < m_parent_pool.m_options.retirement_idle_periods) {
+                continue;
+            }
+
+            if (!m_parent_pool.try_retire_worker(now)) {
+                continue;
+            }
+
+            break;
         }
 
         if (!m_task_found_or_abort.load(std::memory_order_relaxed)) {
+            if (dormant()) {
+                break;  // the blocking region we compensated for is over
+            }
+
             continue;
         }
 
         lock.lock();
-        if (m_public_queue.empty() && !m_abort) {
+        if (m_public_queue.empty() && !m_abort && !m_steal_requested) {
             lock.unlock();
             continue;
         }
 
         event_found = true;
-        break;
     }
 
     if (!lock.owns_lock()) {
         lock.lock();
     }
 
+    // a producer might have pushed right before we timed out, its wake-up would be lost otherwise.
+    if (!event_found && (!m_public_queue.empty() || m_steal_requested)) {
+        event_found = true;
+    }
+
     if (!event_found || m_abort) {
+        if (!m_abort) {
+            m_parent_pool.m_retired_thread_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (dormant()) {
+            m_parent_pool.mark_worker_active(m_index);  // enqueuers must not pick a slot that is handed back
+        }
+
         m_idle = true;
         lock.unlock();
         return false;
     }
 
-    assert(!m_public_queue.empty());
+    assert(!m_public_queue.empty() || m_steal_requested);
     m_parent_pool.mark_worker_active(m_index);
+    record_idle_time(std::chrono::steady_clock::now() - idle_start);
     return true;
 }
 
 bool thread_pool_worker::drain_queue_impl() {
     auto aborted = false;
 
-    while (!m_private_queue.empty()) {
+    while (true) {
         balance_work();
 
         if (m_atomic_abort.load(std::memory_order_relaxed)) {
@@ -262,9 +788,11 @@ bool thread_pool_worker::drain_queue_impl() {
             break;
         }
 
-        assert(!m_private_queue.empty());
-        auto task = std::move(m_private_queue.back());
-        m_private_queue.pop_back();
+        concurrencpp::task task;
+        if (!pop_task(task) && !steal_task(task)) {
+            break;
+        }
+
         task();
     }
 
@@ -284,7 +812,7 @@ bool thread_pool_worker::drain_queue() {
     }
 
     assert(lock.owns_lock());
-    assert(!m_public_queue.empty() || m_abort);
+    assert(!m_public_queue.empty() || m_abort || m_steal_requested);
 
     m_task_found_or_abort.store(false, std::memory_order_relaxed);
 
@@ -293,17 +821,60 @@ bool thread_pool_worker::drain_queue() {
         return false;
     }
 
-    assert(m_private_queue.empty());
-    std::swap(m_private_queue, m_public_queue);  // reuse underlying allocations.
+    const auto steal_requested = std::exchange(m_steal_requested, false);
+
     lock.unlock();
 
+    const auto popped_count = m_public_queue.pop_all(m_public_batches);
+    m_public_task_count.fetch_sub(static_cast<std::intptr_t>(popped_count), std::memory_order_relaxed);
+
+    for (size_t lane = 0; lane < k_lane_count; lane++) {
+        auto& public_batch = m_public_batches[lane];
+        for (auto& task : public_batch) {
+            m_private_queues[lane].push(task);
+        }
+
+        public_batch.clear();
+    }
+
+    if (steal_requested) {
+        // we were woken up to steal. keep the searching token only if we are about to use it.
+        if (private_task_count() == 0) {
+            m_searching = true;
+        } else {
+            m_parent_pool.end_searching();
+        }
+    }
+
     return drain_queue_impl();
 }
 
+void thread_pool_worker::bind_to_numa_node() {
+    if (m_numa_partition == nullptr) {
+        return;
+    }
+
+    thread::set_affinity(m_numa_partition->cpus);
+
+    if (std::exchange(m_queue_relocated, true)) {
+        return;
+    }
+
+    try {
+        for (auto& private_queue : m_private_queues) {
+            private_queue.relocate();
+        }
+    } catch (...) {
+        // keep the current buffer, it's only slower to access.
+    }
+}
+
 void thread_pool_worker::work_loop() {
     s_tl_thread_pool_data.this_worker = this;
     s_tl_thread_pool_data.this_thread_index = m_index;
 
+    bind_to_numa_node();
+
     while (true) {
         if (!drain_queue()) {
             return;
@@ -324,85 +895,136 @@ void thread_pool_worker::ensure_worker_active(bool first_enqueuer, std::unique_l
         return;
     }
 
-    auto stale_worker = std::move(m_thread);
-    m_thread = thread(m_worker_name, [this] {
-        work_loop();
-    });
-
+    // creating the thread and joining the stale one is left to the spawner, enqueuers never wait for either.
     m_idle = false;
     lock.unlock();
 
+    m_parent_pool.request_worker_spawn(m_index);
+}
+
+bool thread_pool_worker::start_thread() {
+    auto stale_worker = std::move(m_thread);
+    auto started = true;
+
+    try {
+        m_thread = thread(
+            m_worker_name,
+            [this] {
+                work_loop();
+            },
+            &m_parent_pool.m_options.thread_options);
+
+        m_parent_pool.m_spawned_thread_count.fetch_add(1, std::memory_order_relaxed);
+    } catch (...) {
+        // the worker stays marked as active: its queue may already hold tasks, and enqueuers that append to a non-empty
+        // queue don't ask for a thread again. the spawner keeps retrying instead.
+        started = false;
+    }
+
     if (stale_worker.joinable()) {
         stale_worker.join();
     }
+
+    return started;
 }
 
-void thread_pool_worker::enqueue_foreign(concurrencpp::task& task) {
-    std::unique_lock<std::mutex> lock(m_lock);
-    if (m_abort) {
+void thread_pool_worker::on_foreign_push(mpsc_push_status status, size_t task_count) {
+    if (status == mpsc_push_status::closed) {
         throw_runtime_shutdown_exception(m_parent_pool.name);
     }
 
-    m_task_found_or_abort.store(true, std::memory_order_relaxed);
+    m_public_task_count.fetch_add(static_cast<std::intptr_t>(task_count), std::memory_order_relaxed);
 
-    const auto is_empty = m_public_queue.empty();
-    m_public_queue.emplace_back(std::move(task));
-    ensure_worker_active(is_empty, lock);
-}
+    if (status == mpsc_push_status::appended) {
+        return;  // whoever made the queue non-empty is responsible for waking the worker up
+    }
+
+    m_task_found_or_abort.store(true, std::memory_order_relaxed);
 
-void thread_pool_worker::enqueue_foreign(std::span<concurrencpp::task> tasks) {
     std::unique_lock<std::mutex> lock(m_lock);
     if (m_abort) {
-        throw_runtime_shutdown_exception(m_parent_pool.name);
+        // the queue has accepted the task, a closed queue is the only rejection.
+        // shutdown will destroy the task when it clears the queue, like any other task that was enqueued before it
+        return;
     }
 
-    m_task_found_or_abort.store(true, std::memory_order_relaxed);
+    ensure_worker_active(true, lock);
+}
 
-    const auto is_empty = m_public_queue.empty();
-    m_public_queue.insert(m_public_queue.end(), std::make_move_iterator(tasks.begin()), std::make_move_iterator(tasks.end()));
-    ensure_worker_active(is_empty, lock);
+void thread_pool_worker::enqueue_foreign(concurrencpp::task& task, size_t lane) {
+    if (m_atomic_abort.load(std::memory_order_relaxed)) {
+        throw_runtime_shutdown_exception(m_parent_pool.name);
+    }
+
+    on_foreign_push(m_public_queue.push(task, lane), 1);
 }
 
-void thread_pool_worker::enqueue_foreign(std::deque<task>::iterator begin, std::deque<task>::iterator end) {
-    std::unique_lock<std::mutex> lock(m_lock);
-    if (m_abort) {
+void thread_pool_worker::enqueue_foreign(std::span<concurrencpp::task> tasks, size_t lane) {
+    if (m_atomic_abort.load(std::memory_order_relaxed)) {
         throw_runtime_shutdown_exception(m_parent_pool.name);
     }
 
-    m_task_found_or_abort.store(true, std::memory_order_relaxed);
+    on_foreign_push(m_public_queue.push(tasks, lane), tasks.size());
+}
 
-    const auto is_empty = m_public_queue.empty();
-    m_public_queue.insert(m_public_queue.end(), std::make_move_iterator(begin), std::make_move_iterator(end));
-    ensure_worker_active(is_empty, lock);
+void thread_pool_worker::enqueue_foreign(std::span<concurrencpp::task>::iterator begin,
+                                         std::span<concurrencpp::task>::iterator end,
+                                         size_t lane) {
+    enqueue_foreign(std::span<concurrencpp::task>(begin, end), lane);
 }
 
-void thread_pool_worker::enqueue_foreign(std::span<concurrencpp::task>::iterator begin, std::span<concurrencpp::task>::iterator end) {
-    std::unique_lock<std::mutex> lock(m_lock);
-    if (m_abort) {
+void thread_pool_worker::enqueue_local(concurrencpp::task& task, size_t lane) {
+    if (m_atomic_abort.load(std::memory_order_relaxed)) {
         throw_runtime_shutdown_exception(m_parent_pool.name);
     }
 
-    m_task_found_or_abort.store(true, std::memory_order_relaxed);
-
-    const auto is_empty = m_public_queue.empty();
-    m_public_queue.insert(m_public_queue.end(), std::make_move_iterator(begin), std::make_move_iterator(end));
-    ensure_worker_active(is_empty, lock);
+    m_private_queues[lane].push(task);
 }
 
-void thread_pool_worker::enqueue_local(concurrencpp::task& task) {
+void thread_pool_worker::enqueue_local(std::span<concurrencpp::task> tasks, size_t lane) {
     if (m_atomic_abort.load(std::memory_order_relaxed)) {
         throw_runtime_shutdown_exception(m_parent_pool.name);
     }
 
-    m_private_queue.emplace_back(std::move(task));
+    m_private_queues[lane].push(tasks);
 }
 
-void thread_pool_worker::enqueue_local(std::span<concurrencpp::task> tasks) {
+void thread_pool_worker::swap_next_task(concurrencpp::task& task) {
     if (m_atomic_abort.load(std::memory_order_relaxed)) {
         throw_runtime_shutdown_exception(m_parent_pool.name);
     }
 
-    m_private_queue.insert(m_private_queue.end(), std::make_move_iterator(tasks.begin()), std::make_move_iterator(tasks.end()));
+    std::swap(m_next_task, task);
+}
+
+void thread_pool_worker::request_steal() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (m_abort) {
+        lock.unlock();
+        m_parent_pool.end_searching();
+        return;
+    }
+
+    m_steal_requested = true;
+    m_task_found_or_abort.store(true, std::memory_order_relaxed);
+    ensure_worker_active(true, lock);
+}
+
+void thread_pool_worker::prewarm() {
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        assert(m_idle);
+        m_idle = false;
+    }
+
+    if (!start_thread()) {
+        m_parent_pool.request_worker_spawn(m_index);  // picked up once the spawner is started
+    }
+}
+
+bool thread_pool_worker::try_steal(concurrencpp::task& task) noexcept {
+    size_t lane = 0;
+    return steal_from_lanes(task, lane);
 }
 
 void thread_pool_worker::shutdown() {
@@ -422,17 +1044,102 @@ void thread_pool_worker::shutdown() {
         m_thread.join();
     }
 
-    decltype(m_public_queue) public_queue;
-    decltype(m_private_queue) private_queue;
+    // a spawn request might have been dropped by the stopped spawner
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_idle = true;
+}
 
-    {
-        std::unique_lock<std::mutex> lock(m_lock);
-        public_queue = std::move(m_public_queue);
-        private_queue = std::move(m_private_queue);
+void thread_pool_worker::clear_tasks() noexcept {
+    m_public_queue.close();
+
+    for (auto& private_queue : m_private_queues) {
+        private_queue.clear();
+    }
+
+    m_next_task.clear();
+}
+
+bool thread_pool_worker::dormant() const noexcept {
+    return m_compensation_slot && !m_compensating.load(std::memory_order_acquire);
+}
+
+size_t thread_pool_worker::hand_over_tasks(thread_pool_worker& substitute) {
+    // oldest tasks first, the next-task slot holds the newest continuation but it would have run first.
+    if (m_next_task) {
+        m_donation_buffers[k_next_task_lane].emplace_back(std::move(m_next_task));
+    }
+
+    for (size_t lane = 0; lane < k_lane_count; lane++) {
+        auto& private_queue = m_private_queues[lane];
+        while (!private_queue.empty()) {
+            concurrencpp::task task;
+            if (private_queue.steal(task)) {  // a thief might hold the steal lock for a moment
+                m_donation_buffers[lane].emplace_back(std::move(task));
+            }
+        }
+    }
+
+    const auto popped_count = m_public_queue.pop_all(m_public_batches);
+    m_public_task_count.fetch_sub(static_cast<std::intptr_t>(popped_count), std::memory_order_relaxed);
+
+    for (size_t lane = 0; lane < k_lane_count; lane++) {
+        auto& donation_buffer = m_donation_buffers[lane];
+        auto& public_batch = m_public_batches[lane];
+        donation_buffer.insert(donation_buffer.end(),
+                               std::make_move_iterator(public_batch.begin()),
+                               std::make_move_iterator(public_batch.end()));
+        public_batch.clear();
+    }
+
+    size_t task_count = 0;
+
+    try {
+        for (size_t lane = 0; lane < k_lane_count; lane++) {
+            auto& donation_buffer = m_donation_buffers[lane];
+            if (!donation_buffer.empty()) {
+                substitute.enqueue_foreign(donation_buffer, lane);
+                task_count += donation_buffer.size();
+                donation_buffer.clear();
+            }
+        }
+    } catch (...) {
+        // the substitute was shut down, so are we.
+        for (auto& donation_buffer : m_donation_buffers) {
+            donation_buffer.clear();
+        }
+
+        throw;
     }
 
-    public_queue.clear();
-    private_queue.clear();
+    return task_count;
+}
+
+size_t thread_pool_worker::begin_blocking() {
+    m_blocked.store(true, std::memory_order_relaxed);
+    return m_parent_pool.begin_blocking(*this);
+}
+
+void thread_pool_worker::end_blocking(size_t compensation_slot) noexcept {
+    m_blocked.store(false, std::memory_order_relaxed);
+    m_parent_pool.end_blocking(compensation_slot);
+}
+
+bool thread_pool_worker::blocked() const noexcept {
+    return m_blocked.load(std::memory_order_relaxed);
+}
+
+bool thread_pool_worker::activate_compensation() noexcept {
+    assert(m_compensation_slot);
+    auto expected = false;
+    return m_compensating.compare_exchange_strong(expected, true, std::memory_order_acq_rel);
+}
+
+void thread_pool_worker::deactivate_compensation() noexcept {
+    assert(m_compensation_slot);
+    m_compensating.store(false, std::memory_order_release);
+
+    // wake the slot up so it retires right away instead of waiting out its idle time
+    m_semaphore.release();
 }
 
 std::chrono::milliseconds thread_pool_worker::max_worker_idle_time() const noexcept {
@@ -440,25 +1147,188 @@ std::chrono::milliseconds thread_pool_worker::max_worker_idle_time() const noexc
 }
 
 bool thread_pool_worker::appears_empty() const noexcept {
-    return m_private_queue.empty() && !m_task_found_or_abort.load(std::memory_order_relaxed);
+    return private_task_count() == 0 && !m_next_task && !m_task_found_or_abort.load(std::memory_order_relaxed);
 }
 
-thread_pool_executor::thread_pool_executor(std::string_view pool_name, size_t pool_size, std::chrono::milliseconds max_idle_time) :
-    derivable_executor<concurrencpp::thread_pool_executor>(pool_name), m_round_robin_cursor(0), m_idle_workers(pool_size),
-    m_abort(false) {
-    m_workers.reserve(pool_size);
+size_t thread_pool_worker::approx_load() const noexcept {
+    const auto public_task_count = m_public_task_count.load(std::memory_order_relaxed);
+    return private_task_count() + static_cast<size_t>(std::max<std::intptr_t>(public_task_count, 0));
+}
 
-    for (size_t i = 0; i < pool_size; i++) {
-        m_workers.emplace_back(*this, i, pool_size, max_idle_time);
+thread_pool_executor::thread_pool_executor(std::string_view pool_name,
+                                           size_t pool_size,
+                                           std::chrono::milliseconds max_idle_time,
+                                           const thread_pool_executor_options& options) :
+    derivable_executor<concurrencpp::thread_pool_executor>(pool_name), m_pool_size(pool_size), m_round_robin_cursor(0),
+    m_idle_workers(pool_size + options.max_compensation_workers), m_searching_worker_count(0), m_abort(false), m_spawner_abort(false),
+    m_spawned_thread_count(0), m_retired_thread_count(0), m_blocked_worker_count(0), m_compensating_worker_count(0),
+    m_last_retirement_time((std::chrono::steady_clock::now() - max_idle_time).time_since_epoch().count()), m_options(options),
+    m_numa_partitions(details::make_numa_partitions(pool_size, options)) {
+    const auto worker_count = pool_size + options.max_compensation_workers;
+    m_workers.reserve(worker_count);
+
+    for (size_t i = 0; i < worker_count; i++) {
+        m_workers.emplace_back(*this, i, worker_count, max_idle_time, partition_of_worker(i), i >= pool_size);
     }
 
+    // a worker has at most one pending spawn, so retrying a failed spawn never allocates (which is likely to fail as well)
+    m_failed_spawns.reserve(worker_count);
+
+    // compensation slots only become visible to enqueuers once a worker blocks
     for (size_t i = 0; i < pool_size; i++) {
         m_idle_workers.set_idle(i);
     }
+
+    try {
+        if (options.prewarm_workers) {
+            for (size_t i = 0; i < pool_size; i++) {
+                m_workers[i].prewarm();
+            }
+        }
+
+        // even a fully prewarmed pool needs the spawner, it keeps retrying worker threads that failed to start.
+        // the spawner lives as long as the pool, so every pool owns one thread on top of its workers.
+        m_spawner = details::thread(details::make_executor_worker_name(name) + " spawner", [this] {
+            spawner_loop();
+        });
+    } catch (...) {
+        // prewarmed workers are already running, they must be joined before they are destroyed
+        for (auto& worker : m_workers) {
+            worker.shutdown();
+        }
+
+        throw;
+    }
+}
+
+void thread_pool_executor::request_worker_spawn(size_t index) {
+    {
+        std::unique_lock<std::mutex> lock(m_spawner_lock);
+        if (m_spawner_abort) {
+            return;
+        }
+
+        m_spawn_requests.emplace_back(index);
+    }
+
+    m_spawner_condition.notify_one();
+}
+
+bool thread_pool_executor::try_retire_worker(std::chrono::steady_clock::time_point now) noexcept {
+    if (!m_options.staggered_retirement) {
+        return true;
+    }
+
+    // at most one surplus worker retires per idle period, so a burst of idleness doesn't tear the whole pool down
+    const auto now_count = now.time_since_epoch().count();
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(max_worker_idle_time()).count();
+    auto last_retirement = m_last_retirement_time.load(std::memory_order_relaxed);
+
+    do {
+        if (now_count - last_retirement < period) {
+            return false;
+        }
+    } while (!m_last_retirement_time.compare_exchange_weak(last_retirement, now_count, std::memory_order_relaxed));
+
+    return true;
+}
+
+void thread_pool_executor::spawner_loop() {
+    std::vector<size_t> spawn_requests;
+    auto& failed_spawns = m_failed_spawns;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_spawner_lock);
+            const auto has_requests = [this] {
+                return m_spawner_abort || !m_spawn_requests.empty();
+            };
+
+            if (failed_spawns.empty()) {
+                m_spawner_condition.wait(lock, has_requests);
+            } else {
+                m_spawner_condition.wait_for(lock, details::consts::k_thread_pool_spawn_retry_delay, has_requests);
+            }
+
+            if (m_spawner_abort) {
+                return;
+            }
+
+            std::swap(spawn_requests, m_spawn_requests);
+        }
+
+        const auto still_failed = std::remove_if(failed_spawns.begin(), failed_spawns.end(), [this](const auto index) {
+            return m_workers[index].start_thread();
+        });
+
+        failed_spawns.erase(still_failed, failed_spawns.end());
+
+        for (const auto index : spawn_requests) {
+            if (!m_workers[index].start_thread()) {
+                failed_spawns.emplace_back(index);
+            }
+        }
+
+        spawn_requests.clear();
+    }
+}
+
+const thread_pool_numa_partition* thread_pool_executor::partition_of_worker(size_t index) const noexcept {
+    for (const auto& partition : m_numa_partitions) {
+        if (index >= partition.begin && index < partition.end) {
+            return &partition;
+        }
+    }
+
+    return nullptr;
+}
+
+const thread_pool_numa_partition* thread_pool_executor::partition_of_current_node() const noexcept {
+    if (m_numa_partitions.empty()) {
+        return nullptr;
+    }
+
+    const auto& topology = details::numa_topology::system();
+    const auto node_index = topology.current_node_index();
+    if (node_index == static_cast<size_t>(-1)) {
+        return nullptr;
+    }
+
+    const auto node_id = topology.nodes()[node_index].id;
+    for (const auto& partition : m_numa_partitions) {
+        if (partition.node_id == node_id) {
+            return &partition;
+        }
+    }
+
+    return nullptr;
+}
+
+size_t thread_pool_executor::find_idle_worker(size_t caller_index) noexcept {
+    const auto partition = (caller_index != static_cast<size_t>(-1)) ? partition_of_worker(caller_index) : partition_of_current_node();
+
+    if (partition != nullptr) {
+        const auto idle_worker_pos = m_idle_workers.find_idle_worker(caller_index, partition->begin, partition->end);
+        if (idle_worker_pos != static_cast<size_t>(-1)) {
+            return idle_worker_pos;
+        }
+    }
+
+    return m_idle_workers.find_idle_worker(caller_index);
 }
 
 void thread_pool_executor::find_idle_workers(size_t caller_index, std::vector<size_t>& buffer, size_t max_count) noexcept {
-    m_idle_workers.find_idle_workers(caller_index, buffer, max_count);
+    const auto partition = partition_of_worker(caller_index);
+    if (partition == nullptr) {
+        return m_idle_workers.find_idle_workers(caller_index, buffer, max_count);
+    }
+
+    // same-node workers first
+    m_idle_workers.find_idle_workers(caller_index, buffer, max_count, partition->begin, partition->end);
+
+    if (buffer.size() < max_count) {
+        m_idle_workers.find_idle_workers(caller_index, buffer, max_count - buffer.size());
+    }
 }
 
 thread_pool_worker& thread_pool_executor::worker_at(size_t index) noexcept {
@@ -476,73 +1346,310 @@ void thread_pool_executor::mark_worker_active(size_t index) noexcept {
     m_idle_workers.set_active(index);
 }
 
+void thread_pool_executor::begin_searching() noexcept {
+    m_searching_worker_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void thread_pool_executor::end_searching() noexcept {
+    const auto before = m_searching_worker_count.fetch_sub(1, std::memory_order_relaxed);
+    assert(before != 0);
+    (void)before;
+}
+
+void thread_pool_executor::wake_thief(size_t caller_index) {
+    // only one worker is woken up at a time, it wakes up the next one if it finds more work.
+    if (m_idle_workers.approx_size() == 0 || m_searching_worker_count.load(std::memory_order_relaxed) != 0) {
+        return;
+    }
+
+    size_t expected = 0;
+    if (!m_searching_worker_count.compare_exchange_strong(expected, 1, std::memory_order_relaxed)) {
+        return;
+    }
+
+    const auto idle_worker_pos = find_idle_worker(caller_index);
+    if (idle_worker_pos == static_cast<size_t>(-1)) {
+        return end_searching();
+    }
+
+    m_workers[idle_worker_pos].request_steal();  // the searching token is handed over to the thief
+}
+
+bool thread_pool_executor::steal_task(size_t thief_index, concurrencpp::task& task) noexcept {
+    const auto partition = partition_of_worker(thief_index);
+
+    // same-node victims first
+    if (partition != nullptr) {
+        const auto partition_size = partition->end - partition->begin;
+        for (size_t i = 1; i < partition_size; i++) {
+            const auto victim_index = partition->begin + (thief_index - partition->begin + i) % partition_size;
+            if (m_workers[victim_index].try_steal(task)) {
+                return true;
+            }
+        }
+    }
+
+    const auto worker_count = m_workers.size();
+    for (size_t i = 1; i < worker_count; i++) {
+        const auto victim_index = (thief_index + i) % worker_count;
+        if (partition != nullptr && victim_index >= partition->begin && victim_index < partition->end) {
+            continue;
+        }
+
+        if (m_workers[victim_index].try_steal(task)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void thread_pool_executor::enqueue(concurrencpp::task task) {
-    const auto this_worker = details::s_tl_thread_pool_data.this_worker;
+    enqueue(std::move(task), task_priority::normal);
+}
+
+void thread_pool_executor::enqueue(std::span<concurrencpp::task> tasks) {
+    enqueue(tasks, task_priority::normal);
+}
+
+void thread_pool_executor::enqueue(concurrencpp::task task, task_priority priority) {
+    const auto lane = details::lane_of(priority);
+    auto this_worker = details::s_tl_thread_pool_data.this_worker;
     const auto this_worker_index = details::s_tl_thread_pool_data.this_thread_index;
 
+    // a blocked worker's queue is on hold until its blocking region ends
+    if (this_worker != nullptr && this_worker->blocked()) {
+        this_worker = nullptr;
+    }
+
+    // the newest continuation runs right after the current task while its data is still hot,
+    // the task it displaces is scheduled as usual.
+    if (this_worker != nullptr && priority == task_priority::normal && m_options.next_task_slot) {
+        this_worker->swap_next_task(task);
+        if (!task) {
+            return;
+        }
+    }
+
     if (this_worker != nullptr && this_worker->appears_empty()) {
-        return this_worker->enqueue_local(task);
+        return this_worker->enqueue_local(task, lane);
     }
 
-    const auto idle_worker_pos = m_idle_workers.find_idle_worker(this_worker_index);
+    const auto idle_worker_pos = find_idle_worker(this_worker_index);
     if (idle_worker_pos != static_cast<size_t>(-1)) {
-        return m_workers[idle_worker_pos].enqueue_foreign(task);
+        return m_workers[idle_worker_pos].enqueue_foreign(task, lane);
     }
 
     if (this_worker != nullptr) {
-        return this_worker->enqueue_local(task);
+        return this_worker->enqueue_local(task, lane);
+    }
+
+    if (const auto partition = partition_of_current_node(); partition != nullptr) {
+        return round_robin_worker(partition->begin, partition->end).enqueue_foreign(task, lane);
     }
 
-    const auto next_worker = m_round_robin_cursor.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
-    m_workers[next_worker].enqueue_foreign(task);
+    round_robin_worker(0, m_pool_size).enqueue_foreign(task, lane);
 }
 
-void thread_pool_executor::enqueue(std::span<concurrencpp::task> tasks) {
-    if (details::s_tl_thread_pool_data.this_worker != nullptr) {
-        return details::s_tl_thread_pool_data.this_worker->enqueue_local(tasks);
+void thread_pool_executor::enqueue(std::span<concurrencpp::task> tasks, task_priority priority) {
+    const auto lane = details::lane_of(priority);
+    const auto this_worker = details::s_tl_thread_pool_data.this_worker;
+
+    if (this_worker != nullptr && !this_worker->blocked()) {
+        return this_worker->enqueue_local(tasks, lane);
     }
 
-    if (tasks.size() < m_workers.size()) {
-        for (auto& task : tasks) {
-            enqueue(std::move(task));
-        }
+    enqueue_external(tasks, lane);
+}
 
+void thread_pool_executor::enqueue_external(std::span<concurrencpp::task> tasks, size_t lane) {
+    const auto task_count = tasks.size();
+    if (task_count == 0) {
         return;
     }
 
-    const auto task_count = tasks.size();
-    const auto total_worker_count = m_workers.size();
-    const auto donation_count = task_count / total_worker_count;
-    auto extra = task_count - donation_count * total_worker_count;
+    const auto partition = partition_of_current_node();
+    const auto range_begin = (partition != nullptr) ? partition->begin : 0;
+    const auto range_end = (partition != nullptr) ? partition->end : m_pool_size;
+    const auto range_size = range_end - range_begin;
 
-    size_t begin = 0;
-    size_t end = donation_count;
+    // claim idle workers so concurrent enqueuers don't pick them as well, they are woken up by the hand-off below.
+    std::vector<size_t> idle_workers;
+    idle_workers.reserve(std::min(task_count, range_size));
+    m_idle_workers.find_idle_workers(static_cast<size_t>(-1), idle_workers, idle_workers.capacity(), range_begin, range_end);
+
+    struct target {
+        size_t load;
+        size_t index;
+        bool claimed;
+    };
+
+    std::vector<target> targets;
+    targets.reserve(range_size);
+
+    // blocked workers get nothing, their compensation workers stand in for them
+    for (auto i = range_begin; i < range_end; i++) {
+        if (!m_workers[i].blocked()) {
+            targets.push_back({m_workers[i].approx_load(), i, false});
+        }
+    }
+
+    for (auto i = m_pool_size; i < m_workers.size() && targets.size() < range_size; i++) {
+        if (!m_workers[i].dormant() && !m_workers[i].blocked()) {
+            targets.push_back({m_workers[i].approx_load(), i, false});
+        }
+    }
 
-    for (size_t i = 0; i < total_worker_count; i++) {
-        assert(begin < task_count);
+    if (targets.empty()) {
+        for (auto i = range_begin; i < range_end; i++) {
+            targets.push_back({m_workers[i].approx_load(), i, false});
+        }
+    }
+
+    for (const auto idle_worker : idle_workers) {
+        const auto claimed_target = std::find_if(targets.begin(), targets.end(), [idle_worker](const auto& target) {
+            return target.index == idle_worker;
+        });
 
+        if (claimed_target == targets.end()) {
+            mark_worker_idle(idle_worker);  // blocked in the meantime
+            continue;
+        }
+
+        claimed_target->load = 0;
+        claimed_target->claimed = true;
+    }
+
+    // claimed workers first among equally loaded ones
+    std::sort(targets.begin(), targets.end(), [](const auto& lhs, const auto& rhs) {
+        if (lhs.load != rhs.load) {
+            return lhs.load < rhs.load;
+        }
+
+        return lhs.claimed && !rhs.claimed;
+    });
+
+    // fill the least loaded workers up to a common level, busy workers with a backlog get nothing.
+    size_t target_count = 0, load_sum = 0;
+    while (target_count < targets.size()) {
+        const auto next_load = targets[target_count].load;
+        if (target_count != 0 && next_load * target_count - load_sum > task_count) {
+            break;
+        }
+
+        load_sum += next_load;
+        ++target_count;
+    }
+
+    const auto level = (task_count + load_sum) / target_count;
+    auto extra = (task_count + load_sum) % target_count;
+
+    // one hand-off per target, which wakes it up at most once
+    size_t begin = 0;
+    for (size_t i = 0; i < target_count; i++) {
+        assert(level >= targets[i].load);
+
+        auto count = level - targets[i].load;
         if (extra != 0) {
-            end++;
-            extra--;
+            ++count;
+            --extra;
+        }
+
+        if (count == 0) {
+            if (targets[i].claimed) {
+                mark_worker_idle(targets[i].index);
+            }
+
+            continue;
+        }
+
+        assert(begin + count <= task_count);
+        m_workers[targets[i].index].enqueue_foreign(tasks.subspan(begin, count), lane);
+        begin += count;
+    }
+
+    assert(begin == task_count);
+}
+
+concurrencpp::details::thread_pool_worker& thread_pool_executor::round_robin_worker(size_t range_begin, size_t range_end) noexcept {
+    assert(range_begin < range_end);
+
+    const auto range_size = range_end - range_begin;
+    const auto cursor = m_round_robin_cursor.fetch_add(1, std::memory_order_relaxed);
+
+    // skip blocked workers, their compensation workers stand in for them
+    for (size_t i = 0; i < range_size; i++) {
+        auto& worker = m_workers[range_begin + (cursor + i) % range_size];
+        if (!worker.blocked()) {
+            return worker;
+        }
+    }
+
+    const auto slot_count = m_workers.size() - m_pool_size;
+    for (size_t i = 0; i < slot_count; i++) {
+        auto& slot = m_workers[m_pool_size + (cursor + i) % slot_count];
+        if (!slot.dormant() && !slot.blocked()) {
+            return slot;
         }
+    }
+
+    return m_workers[range_begin + cursor % range_size];
+}
+
+size_t thread_pool_executor::begin_blocking(details::thread_pool_worker& blocked_worker) {
+    constexpr auto no_slot = static_cast<size_t>(-1);
+
+    m_blocked_worker_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_abort.load(std::memory_order_relaxed)) {
+        return no_slot;
+    }
+
+    auto compensation_slot = no_slot;
+    for (auto i = m_pool_size; i < m_workers.size(); i++) {
+        if (m_workers[i].activate_compensation()) {
+            compensation_slot = i;
+            break;
+        }
+    }
+
+    if (compensation_slot == no_slot) {
+        return no_slot;  // the cap was reached, the blocked worker isn't compensated for
+    }
+
+    m_compensating_worker_count.fetch_add(1, std::memory_order_relaxed);
 
-        assert(end <= task_count);
+    size_t handed_task_count = 0;
 
-        auto tasks_begin_it = tasks.begin() + begin;
-        auto tasks_end_it = tasks.begin() + end;
+    try {
+        handed_task_count = blocked_worker.hand_over_tasks(m_workers[compensation_slot]);
+    } catch (const errors::runtime_shutdown&) {
+        return compensation_slot;  // the pool is being shut down, the handed tasks are destroyed anyway.
+    }
 
-        assert(tasks_begin_it < tasks.end());
-        assert(tasks_end_it <= tasks.end());
+    // an empty substitute is picked by the next enqueuer, a busy one publishes itself once it runs out of tasks
+    if (handed_task_count == 0) {
+        mark_worker_idle(compensation_slot);
+    }
 
-        m_workers[i].enqueue_foreign(tasks_begin_it, tasks_end_it);
+    return compensation_slot;
+}
 
-        begin = end;
-        end += donation_count;
+void thread_pool_executor::end_blocking(size_t compensation_slot) noexcept {
+    m_blocked_worker_count.fetch_sub(1, std::memory_order_relaxed);
+
+    if (compensation_slot == static_cast<size_t>(-1)) {
+        return;
     }
+
+    // the substitute finishes the tasks it already has, then retires
+    mark_worker_active(compensation_slot);
+    m_workers[compensation_slot].deactivate_compensation();
+    m_compensating_worker_count.fetch_sub(1, std::memory_order_relaxed);
 }
 
 int thread_pool_executor::max_concurrency_level() const noexcept {
-    return static_cast<int>(m_workers.size());
+    return static_cast<int>(m_pool_size);
 }
 
 bool thread_pool_executor::shutdown_requested() const {
@@ -555,11 +1662,78 @@ void thread_pool_executor::shutdown() {
         return;  // shutdown had been called before.
     }
 
+    {
+        std::unique_lock<std::mutex> lock(m_spawner_lock);
+        m_spawner_abort = true;
+    }
+
+    m_spawner_condition.notify_one();
+
+    if (m_spawner.joinable()) {
+        m_spawner.join();
+    }
+
     for (auto& worker : m_workers) {
         worker.shutdown();
     }
+
+    // workers might steal from each other up until they are joined.
+    for (auto& worker : m_workers) {
+        worker.clear_tasks();
+    }
 }
 
 std::chrono::milliseconds thread_pool_executor::max_worker_idle_time() const noexcept {
     return m_workers[0].max_worker_idle_time();
+}
+
+const thread_pool_executor_options& thread_pool_executor::options() const noexcept {
+    return m_options;
+}
+
+size_t thread_pool_executor::spawned_thread_count() const noexcept {
+    return m_spawned_thread_count.load(std::memory_order_relaxed);
+}
+
+size_t thread_pool_executor::retired_thread_count() const noexcept {
+    return m_retired_thread_count.load(std::memory_order_relaxed);
+}
+
+size_t thread_pool_executor::blocked_worker_count() const noexcept {
+    return m_blocked_worker_count.load(std::memory_order_relaxed);
+}
+
+size_t thread_pool_executor::compensating_worker_count() const noexcept {
+    return m_compensating_worker_count.load(std::memory_order_relaxed);
+}
+
+/*
+        blocking_region
+*/
+
+namespace concurrencpp::details {
+    namespace {
+        thread_pool_worker* unblocked_current_worker() noexcept {
+            const auto this_worker = s_tl_thread_pool_data.this_worker;
+            if (this_worker == nullptr || this_worker->blocked()) {
+                return nullptr;  // not a worker thread, or a nested region
+            }
+
+            return this_worker;
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+blocking_region::blocking_region() :
+    m_worker(details::unblocked_current_worker()),
+    m_compensation_slot((m_worker != nullptr) ? m_worker->begin_blocking() : static_cast<size_t>(-1)) {}
+
+blocking_region::~blocking_region() noexcept {
+    if (m_worker != nullptr) {
+        m_worker->end_blocking(m_compensation_slot);
+    }
+}
+
+bool blocking_region::compensated() const noexcept {
+    return m_compensation_slot != static_cast<size_t>(-1);
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "concurrencpp/executors/worker_thread_executor.h"
 #include "concurrencpp/executors/constants.h"
+#include "concurrencpp/threads/cpu_relax.h"
 
 namespace concurrencpp::details {
     static thread_local worker_thread_executor* s_tl_this_worker = nullptr;
@@ -7,12 +8,15 @@ namespace concurrencpp::details {
 
 using concurrencpp::worker_thread_executor;
 
-worker_thread_executor::worker_thread_executor() :
+worker_thread_executor::worker_thread_executor(const executor_thread_options& thread_options, bool busy_poll) :
     derivable_executor<concurrencpp::worker_thread_executor>(details::consts::k_worker_thread_executor_name),
-    m_private_atomic_abort(false), m_semaphore(0), m_atomic_abort(false), m_abort(false) {
-    m_thread = details::thread(details::make_executor_worker_name(name), [this] {
-        work_loop();
-    });
+    m_private_atomic_abort(false), m_semaphore(0), m_atomic_abort(false), m_thread_options(thread_options), m_busy_poll(busy_poll) {
+    m_thread = details::thread(
+        details::make_executor_worker_name(name),
+        [this] {
+            work_loop();
+        },
+        &m_thread_options);
 }
 
 bool worker_thread_executor::drain_queue_impl() {
@@ -30,38 +34,29 @@ bool worker_thread_executor::drain_queue_impl() {
     return true;
 }
 
-void worker_thread_executor::wait_for_task(std::unique_lock<std::mutex>& lock) {
-    assert(lock.owns_lock());
-    if (!m_public_queue.empty() || m_abort) {
+void worker_thread_executor::wait_for_task() {
+    if (m_busy_poll) {
+        while (m_public_queue.empty() && !m_atomic_abort.load(std::memory_order_relaxed)) {
+            details::cpu_relax();
+        }
+
         return;
     }
 
-    while (true) {
-        lock.unlock();
-
+    while (m_public_queue.empty() && !m_atomic_abort.load(std::memory_order_relaxed)) {
         m_semaphore.acquire();
-
-        lock.lock();
-        if (!m_public_queue.empty() || m_abort) {
-            break;
-        }
     }
 }
 
 bool worker_thread_executor::drain_queue() {
-    std::unique_lock<std::mutex> lock(m_lock);
-    wait_for_task(lock);
+    wait_for_task();
 
-    assert(lock.owns_lock());
-    assert(!m_public_queue.empty() || m_abort);
-
-    if (m_abort) {
+    if (m_atomic_abort.load(std::memory_order_relaxed)) {
         return false;
     }
 
     assert(m_private_queue.empty());
-    std::swap(m_private_queue, m_public_queue);  // reuse underlying allocations.
-    lock.unlock();
+    m_public_queue.pop_all(m_private_queue);
 
     return drain_queue_impl();
 }
@@ -93,31 +88,31 @@ void worker_thread_executor::enqueue_local(std::span<concurrencpp::task> tasks)
 }
 
 void worker_thread_executor::enqueue_foreign(concurrencpp::task& task) {
-    std::unique_lock<std::mutex> lock(m_lock);
-    if (m_abort) {
+    if (m_atomic_abort.load(std::memory_order_relaxed)) {
         details::throw_runtime_shutdown_exception(name);
     }
 
-    const auto is_empty = m_public_queue.empty();
-    m_public_queue.emplace_back(std::move(task));
-    lock.unlock();
+    const auto status = m_public_queue.push(task);
+    if (status == details::mpsc_push_status::closed) {
+        details::throw_runtime_shutdown_exception(name);
+    }
 
-    if (is_empty) {
+    if (status == details::mpsc_push_status::first && !m_busy_poll) {
         m_semaphore.release();
     }
 }
 
 void worker_thread_executor::enqueue_foreign(std::span<concurrencpp::task> tasks) {
-    std::unique_lock<std::mutex> lock(m_lock);
-    if (m_abort) {
+    if (m_atomic_abort.load(std::memory_order_relaxed)) {
         details::throw_runtime_shutdown_exception(name);
     }
 
-    const auto is_empty = m_public_queue.empty();
-    m_public_queue.insert(m_public_queue.end(), std::make_move_iterator(tasks.begin()), std::make_move_iterator(tasks.end()));
-    lock.unlock();
+    const auto status = m_public_queue.push(tasks);
+    if (status == details::mpsc_push_status::closed) {
+        details::throw_runtime_shutdown_exception(name);
+    }
 
-    if (is_empty) {
+    if (status == details::mpsc_push_status::first && !m_busy_poll) {
         m_semaphore.release();
     }
 }
@@ -152,26 +147,16 @@ void worker_thread_executor::shutdown() {
         return;  // shutdown had been called before.
     }
 
-    {
-        std::unique_lock<std::mutex> lock(m_lock);
-        m_abort = true;
-    }
-
     m_semaphore.release();
 
     if (m_thread.joinable()) {
         m_thread.join();
     }
 
-    decltype(m_private_queue) private_queue;
-    decltype(m_public_queue) public_queue;
-
-    {
-        std::unique_lock<std::mutex> lock(m_lock);
-        private_queue = std::move(m_private_queue);
-        public_queue = std::move(m_public_queue);
-    }
+    m_public_queue.close();
+    m_private_queue.clear();
+}
 
-    private_queue.clear();
-    public_queue.clear();
+bool worker_thread_executor::busy_polling() const noexcept {
+    return m_busy_poll;
 }
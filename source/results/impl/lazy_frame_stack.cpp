@@ -0,0 +1,152 @@
+#include "concurrencpp/results/impl/lazy_frame_stack.h"
+
+#include <new>
+#include <atomic>
+#include <utility>
+
+#include <cassert>
+
+using concurrencpp::details::lazy_frame_stack;
+
+namespace concurrencpp::details {
+    namespace {
+        constexpr size_t k_segment_size = 64 * 1024;
+
+        struct alignas(std::max_align_t) frame_stack_segment {
+            std::atomic_size_t ref_count {1};  // live frames, plus one while it's the current segment of a thread
+            size_t top = 0;                    // touched only by the thread the segment is current for
+
+            std::byte* data() noexcept {
+                return reinterpret_cast<std::byte*>(this + 1);
+            }
+        };
+
+        struct alignas(std::max_align_t) frame_header {
+            frame_stack_segment* segment;
+        };
+
+        constexpr size_t k_segment_capacity = k_segment_size - sizeof(frame_stack_segment);
+
+        size_t footprint_of(size_t frame_size) noexcept {
+            constexpr auto alignment = alignof(std::max_align_t);
+            return (sizeof(frame_header) + frame_size + alignment - 1) / alignment * alignment;
+        }
+
+        class thread_frame_stack {
+
+           private:
+            frame_stack_segment* m_current = nullptr;
+            frame_stack_segment* m_spare = nullptr;
+            bool m_destroyed = false;
+
+            frame_stack_segment* take_segment() {
+                if (m_spare == nullptr) {
+                    return new (::operator new(k_segment_size)) frame_stack_segment();
+                }
+
+                const auto segment = std::exchange(m_spare, nullptr);
+                segment->ref_count.store(1, std::memory_order_relaxed);
+                segment->top = 0;
+                return segment;
+            }
+
+            void release(frame_stack_segment* segment) noexcept {
+                if (segment->ref_count.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                    return;
+                }
+
+                if (!m_destroyed && m_spare == nullptr) {
+                    m_spare = segment;
+                    return;
+                }
+
+                ::operator delete(segment);
+            }
+
+           public:
+            ~thread_frame_stack() noexcept {
+                m_destroyed = true;
+
+                if (m_spare != nullptr) {
+                    ::operator delete(std::exchange(m_spare, nullptr));
+                }
+
+                // frames that are still alive keep the segment until they are freed
+                if (m_current != nullptr) {
+                    release(std::exchange(m_current, nullptr));
+                }
+            }
+
+            // null once the thread is exiting
+            frame_header* allocate(size_t footprint) {
+                assert(footprint <= k_segment_capacity);
+
+                if (m_destroyed) {
+                    return nullptr;
+                }
+
+                // all the frames of the current segment are gone, start over from the bottom
+                if (m_current != nullptr && m_current->ref_count.load(std::memory_order_acquire) == 1) {
+                    m_current->top = 0;
+                }
+
+                if (m_current == nullptr || m_current->top + footprint > k_segment_capacity) {
+                    const auto segment = take_segment();
+                    if (m_current != nullptr) {
+                        release(m_current);
+                    }
+
+                    m_current = segment;
+                }
+
+                const auto header = reinterpret_cast<frame_header*>(m_current->data() + m_current->top);
+                header->segment = m_current;
+                m_current->top += footprint;
+                m_current->ref_count.fetch_add(1, std::memory_order_relaxed);
+                return header;
+            }
+
+            void deallocate(frame_header* header, size_t footprint) noexcept {
+                const auto segment = header->segment;
+
+                // the frame on top of the current segment, the common case for recursive coroutines
+                if (segment == m_current && reinterpret_cast<std::byte*>(header) + footprint == segment->data() + segment->top) {
+                    segment->top -= footprint;
+                }
+
+                release(segment);
+            }
+        };
+
+        thread_local thread_frame_stack s_tl_frame_stack;
+    }  // namespace
+}  // namespace concurrencpp::details
+
+void* lazy_frame_stack::allocate(size_t size) {
+    const auto footprint = footprint_of(size);
+
+    frame_header* header = nullptr;
+    if (footprint <= k_segment_capacity) {
+        header = s_tl_frame_stack.allocate(footprint);
+    }
+
+    if (header == nullptr) {
+        header = static_cast<frame_header*>(::operator new(sizeof(frame_header) + size));
+        header->segment = nullptr;
+    }
+
+    return header + 1;
+}
+
+void lazy_frame_stack::deallocate(void* pointer, size_t size) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    const auto header = static_cast<frame_header*>(pointer) - 1;
+    if (header->segment == nullptr) {
+        return ::operator delete(header);
+    }
+
+    s_tl_frame_stack.deallocate(header, footprint_of(size));
+}
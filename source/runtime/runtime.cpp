@@ -10,6 +10,9 @@
 
 #include "concurrencpp/timers/timer_queue.h"
 
+#include "concurrencpp/threads/numa_topology.h"
+
+#include <string>
 #include <algorithm>
 
 namespace concurrencpp::details {
@@ -56,9 +59,11 @@ void executor_collection::shutdown_all() {
 
 runtime_options::runtime_options() noexcept :
     max_cpu_threads(details::default_max_cpu_workers()),
-    max_thread_pool_executor_waiting_time(details::k_default_max_worker_wait_time),
+    max_thread_pool_executor_waiting_time(details::k_default_max_worker_wait_time), numa_node_pools(false),
     max_background_threads(details::default_max_background_workers()),
     max_background_executor_waiting_time(details::k_default_max_worker_wait_time),
+    max_thread_executor_cached_threads(details::consts::k_thread_executor_default_max_cached_threads),
+    max_thread_executor_waiting_time(details::consts::k_thread_executor_default_max_cached_thread_idle_time),
     max_timer_queue_waiting_time(std::chrono::seconds(details::consts::k_max_timer_queue_worker_waiting_time_sec)) {}
 
 /*
@@ -67,7 +72,7 @@ runtime_options::runtime_options() noexcept :
 
 runtime::runtime() : runtime(runtime_options()) {}
 
-runtime::runtime(const runtime_options& options) {
+runtime::runtime(const runtime_options& options) : m_worker_thread_executor_options(options.worker_thread_executor_options) {
     m_timer_queue = std::make_shared<::concurrencpp::timer_queue>(options.max_timer_queue_waiting_time);
 
     m_inline_executor = std::make_shared<::concurrencpp::inline_executor>();
@@ -75,16 +80,39 @@ runtime::runtime(const runtime_options& options) {
 
     m_thread_pool_executor = std::make_shared<::concurrencpp::thread_pool_executor>(details::consts::k_thread_pool_executor_name,
                                                                                     options.max_cpu_threads,
-                                                                                    options.max_thread_pool_executor_waiting_time);
+                                                                                    options.max_thread_pool_executor_waiting_time,
+                                                                                    options.cpu_pool_options);
     m_registered_executors.register_executor(m_thread_pool_executor);
 
     m_background_executor = std::make_shared<::concurrencpp::thread_pool_executor>(details::consts::k_background_executor_name,
                                                                                    options.max_background_threads,
-                                                                                   options.max_background_executor_waiting_time);
+                                                                                   options.max_background_executor_waiting_time,
+                                                                                   options.background_pool_options);
     m_registered_executors.register_executor(m_background_executor);
 
-    m_thread_executor = std::make_shared<::concurrencpp::thread_executor>();
+    m_thread_executor = std::make_shared<::concurrencpp::thread_executor>(options.thread_executor_options,
+                                                                          options.max_thread_executor_cached_threads,
+                                                                          options.max_thread_executor_waiting_time);
     m_registered_executors.register_executor(m_thread_executor);
+
+    if (!options.numa_node_pools) {
+        return;
+    }
+
+    for (const auto& node : details::numa_topology::system().nodes()) {
+        auto node_pool_options = options.cpu_pool_options;
+        node_pool_options.numa_aware = true;
+        node_pool_options.numa_nodes = {node.id};
+
+        auto executor = std::make_shared<::concurrencpp::thread_pool_executor>(
+            std::string(details::consts::k_numa_node_executor_name) + std::to_string(node.id),
+            node.cpus.size() * details::consts::k_cpu_threadpool_worker_count_factor,
+            options.max_thread_pool_executor_waiting_time,
+            node_pool_options);
+
+        m_registered_executors.register_executor(executor);
+        m_numa_node_executors.emplace_back(std::move(executor));
+    }
 }
 
 concurrencpp::runtime::~runtime() noexcept {
@@ -117,8 +145,24 @@ std::shared_ptr<concurrencpp::thread_executor> runtime::thread_executor() const
     return m_thread_executor;
 }
 
+const std::vector<std::shared_ptr<concurrencpp::thread_pool_executor>>& runtime::numa_node_executors() const noexcept {
+    return m_numa_node_executors;
+}
+
 std::shared_ptr<concurrencpp::worker_thread_executor> runtime::make_worker_thread_executor() {
-    auto executor = std::make_shared<worker_thread_executor>();
+    auto executor = std::make_shared<worker_thread_executor>(m_worker_thread_executor_options);
+    m_registered_executors.register_executor(executor);
+    return executor;
+}
+
+std::shared_ptr<concurrencpp::worker_thread_executor> runtime::make_worker_thread_executor(bool busy_poll,
+                                                                                          std::vector<size_t> cpu_affinity) {
+    auto thread_options = m_worker_thread_executor_options;
+    if (!cpu_affinity.empty()) {
+        thread_options.cpu_affinity = std::move(cpu_affinity);
+    }
+
+    auto executor = std::make_shared<worker_thread_executor>(thread_options, busy_poll);
     m_registered_executors.register_executor(executor);
     return executor;
 }
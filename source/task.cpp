@@ -7,7 +7,7 @@ using concurrencpp::task;
 using concurrencpp::details::vtable;
 
 static_assert(sizeof(task) == concurrencpp::details::task_constants::total_size,
-              "concurrencpp::task - object size is bigger than a cache-line.");
+              "concurrencpp::task - object size is different than CRCPP_TASK_SIZE.");
 
 using concurrencpp::details::callable_vtable;
 using concurrencpp::details::await_via_functor;
@@ -100,6 +100,10 @@ void task::clear() noexcept {
     destroy_fn(m_buffer);
 }
 
+concurrencpp::task_allocation_stats task::allocation_stats() noexcept {
+    return details::task_allocator::stats();
+}
+
 task::operator bool() const noexcept {
     return m_vtable != nullptr;
 }
\ No newline at end of file
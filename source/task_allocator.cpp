@@ -0,0 +1,361 @@
+#include "concurrencpp/task_allocator.h"
+#include "concurrencpp/threads/cache_line.h"
+
+#include <new>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <utility>
+
+#include <cassert>
+
+using concurrencpp::task_allocation_stats;
+using concurrencpp::details::task_allocator;
+using concurrencpp::details::coroutine_frame_allocator;
+
+namespace concurrencpp::details {
+    namespace {
+        constexpr size_t k_size_class_count = 6;
+        constexpr std::array<size_t, k_size_class_count> k_size_classes = {64, 128, 256, 512, 1024, 2048};
+        constexpr size_t k_max_cached_bytes_per_class = 32 * 1024;
+        constexpr size_t k_remote_free_batch_size = 32;
+        constexpr size_t k_no_size_class = static_cast<size_t>(-1);
+
+        size_t size_class_of(size_t size) noexcept {
+            for (size_t i = 0; i < k_size_class_count; i++) {
+                if (size <= k_size_classes[i]) {
+                    return i;
+                }
+            }
+
+            return k_no_size_class;
+        }
+
+        class block_cache;
+
+        struct alignas(std::max_align_t) block_header {
+            block_cache* owner;
+            size_t size_class;
+        };
+
+        struct free_block {
+            free_block* next;
+        };
+
+        block_header* header_of(void* pointer) noexcept {
+            return static_cast<block_header*>(pointer) - 1;
+        }
+
+        void* payload_of(block_header* header) noexcept {
+            return header + 1;
+        }
+
+        free_block* as_free_block(block_header* header) noexcept {
+            return static_cast<free_block*>(payload_of(header));
+        }
+
+        block_header* header_of(free_block* block) noexcept {
+            return header_of(static_cast<void*>(block));
+        }
+
+        void destroy_block(block_header* header) noexcept {
+            ::operator delete(header);
+        }
+
+        void destroy_chain(free_block* head) noexcept {
+            while (head != nullptr) {
+                destroy_block(header_of(std::exchange(head, head->next)));
+            }
+        }
+
+        // owner-only counter which other threads may read at any time
+        void increment(std::atomic_size_t& counter, size_t amount = 1) noexcept {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        /*
+            The free lists of one thread. A cache outlives its thread: once the thread exits, the cache is parked
+            and adopted by the next new thread, so blocks other threads still have to free always have an owner to return to.
+            A parked cache retains no blocks: the blocks freed to it go straight back to the global allocator.
+        */
+        class block_cache {
+
+           private:
+            std::array<free_block*, k_size_class_count> m_free_lists {};
+            std::array<size_t, k_size_class_count> m_free_counts {};
+            std::atomic_size_t m_hit_count {0};
+            std::atomic_size_t m_miss_count {0};
+            std::atomic_size_t m_remote_free_count {0};
+            std::atomic_bool m_parked {false};
+            alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic<free_block*> m_remote_frees {nullptr};
+
+            void push_local(free_block* block, size_t size_class) noexcept {
+                if (m_free_counts[size_class] == k_max_cached_bytes_per_class / k_size_classes[size_class]) {
+                    return destroy_block(header_of(block));
+                }
+
+                block->next = m_free_lists[size_class];
+                m_free_lists[size_class] = block;
+                ++m_free_counts[size_class];
+            }
+
+            void reclaim_remote_frees() noexcept {
+                auto head = m_remote_frees.exchange(nullptr, std::memory_order_acquire);
+                size_t count = 0;
+
+                while (head != nullptr) {
+                    const auto block = std::exchange(head, head->next);
+                    push_local(block, header_of(block)->size_class);
+                    ++count;
+                }
+
+                increment(m_remote_free_count, count);
+            }
+
+           public:
+            void* allocate(size_t size_class) {
+                if (m_free_lists[size_class] == nullptr && m_remote_frees.load(std::memory_order_relaxed) != nullptr) {
+                    reclaim_remote_frees();
+                }
+
+                if (const auto block = m_free_lists[size_class]; block != nullptr) {
+                    m_free_lists[size_class] = block->next;
+                    --m_free_counts[size_class];
+                    increment(m_hit_count);
+                    return block;
+                }
+
+                increment(m_miss_count);
+
+                const auto header = static_cast<block_header*>(::operator new(sizeof(block_header) + k_size_classes[size_class]));
+                header->owner = this;
+                header->size_class = size_class;
+                return payload_of(header);
+            }
+
+            void deallocate_local(block_header* header) noexcept {
+                assert(header->owner == this);
+                push_local(as_free_block(header), header->size_class);
+            }
+
+            void push_remote(free_block* head, free_block* tail) noexcept {
+                if (m_parked.load(std::memory_order_acquire)) {
+                    tail->next = nullptr;
+                    return destroy_chain(head);
+                }
+
+                auto remote_head = m_remote_frees.load(std::memory_order_relaxed);
+                do {
+                    tail->next = remote_head;
+                } while (
+                    !m_remote_frees.compare_exchange_weak(remote_head, head, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            // blocks pushed by threads that raced with parking are reclaimed by the adopting thread
+            void park() noexcept {
+                m_parked.store(true, std::memory_order_release);
+                release_free_blocks();
+            }
+
+            void unpark() noexcept {
+                m_parked.store(false, std::memory_order_relaxed);
+            }
+
+            void release_free_blocks() noexcept {
+                reclaim_remote_frees();
+
+                for (size_t i = 0; i < k_size_class_count; i++) {
+                    destroy_chain(std::exchange(m_free_lists[i], nullptr));
+                    m_free_counts[i] = 0;
+                }
+            }
+
+            void add_stats(task_allocation_stats& stats) const noexcept {
+                stats.hit_count += m_hit_count.load(std::memory_order_relaxed);
+                stats.miss_count += m_miss_count.load(std::memory_order_relaxed);
+                stats.remote_free_count += m_remote_free_count.load(std::memory_order_relaxed);
+            }
+        };
+
+        class block_cache_registry {
+
+           private:
+            std::mutex m_lock;
+            std::vector<std::unique_ptr<block_cache>> m_caches;
+            std::vector<block_cache*> m_parked_caches;
+
+           public:
+            block_cache* adopt() {
+                std::unique_lock<std::mutex> lock(m_lock);
+                if (!m_parked_caches.empty()) {
+                    const auto cache = m_parked_caches.back();
+                    m_parked_caches.pop_back();
+                    cache->unpark();
+                    return cache;
+                }
+
+                return m_caches.emplace_back(std::make_unique<block_cache>()).get();
+            }
+
+            void park(block_cache* cache) noexcept {
+                cache->park();
+
+                std::unique_lock<std::mutex> lock(m_lock);
+
+                try {
+                    m_parked_caches.emplace_back(cache);
+                } catch (...) {
+                    // the cache is never adopted again, the blocks that are still freed to it are released as they arrive.
+                }
+            }
+
+            task_allocation_stats stats() noexcept {
+                task_allocation_stats stats {};
+
+                std::unique_lock<std::mutex> lock(m_lock);
+                for (const auto& cache : m_caches) {
+                    cache->add_stats(stats);
+                }
+
+                return stats;
+            }
+
+            static block_cache_registry& instance() {
+                // leaked on purpose, threads might free blocks during static destruction
+                static auto registry = new block_cache_registry();
+                return *registry;
+            }
+        };
+
+        /*
+            Remote frees are collected per owner and pushed back with one CAS,
+            the batch is flushed when it's full, when a block of another owner is freed and when the thread exits.
+        */
+        struct remote_free_batch {
+            block_cache* owner = nullptr;
+            free_block* head = nullptr;
+            free_block* tail = nullptr;
+            size_t count = 0;
+
+            void flush() noexcept {
+                if (owner == nullptr) {
+                    return;
+                }
+
+                owner->push_remote(head, tail);
+                *this = {};
+            }
+
+            void add(block_cache* block_owner, free_block* block) noexcept {
+                if (owner != block_owner) {
+                    flush();
+                    owner = block_owner;
+                    tail = block;
+                }
+
+                block->next = head;
+                head = block;
+
+                if (++count == k_remote_free_batch_size) {
+                    flush();
+                }
+            }
+        };
+
+        /*
+            Set once the thread's block cache is destroyed. Other thread_local destructors might still allocate or free
+            afterwards, a trivially destructible flag can be read for the whole thread exit while the cache itself can't.
+        */
+        thread_local bool s_tl_block_cache_destroyed = false;
+
+        class thread_block_cache {
+
+           private:
+            block_cache* m_cache = nullptr;
+            remote_free_batch m_remote_batch;
+
+           public:
+            ~thread_block_cache() noexcept {
+                s_tl_block_cache_destroyed = true;
+                m_remote_batch.flush();
+
+                if (m_cache == nullptr) {
+                    return;
+                }
+
+                block_cache_registry::instance().park(std::exchange(m_cache, nullptr));
+            }
+
+            block_cache* get() {
+                if (m_cache == nullptr) {
+                    m_cache = block_cache_registry::instance().adopt();
+                }
+
+                return m_cache;
+            }
+
+            void deallocate(block_header* header) noexcept {
+                const auto owner = header->owner;
+                if (owner == nullptr) {
+                    return destroy_block(header);
+                }
+
+                if (owner == m_cache) {
+                    return owner->deallocate_local(header);
+                }
+
+                m_remote_batch.add(owner, as_free_block(header));
+            }
+        };
+
+        thread_local thread_block_cache s_tl_block_cache;
+    }  // namespace
+}  // namespace concurrencpp::details
+
+void* task_allocator::allocate(size_t size) {
+    const auto size_class = size_class_of(size);
+    if (size_class == k_no_size_class) {
+        return ::operator new(size);
+    }
+
+    if (!s_tl_block_cache_destroyed) {
+        return s_tl_block_cache.get()->allocate(size_class);
+    }
+
+    // the thread is exiting, the block is freed for good once it's deallocated
+    const auto header = static_cast<block_header*>(::operator new(sizeof(block_header) + k_size_classes[size_class]));
+    header->owner = nullptr;
+    header->size_class = size_class;
+    return payload_of(header);
+}
+
+void task_allocator::deallocate(void* pointer, size_t size) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    if (size_class_of(size) == k_no_size_class) {
+        return ::operator delete(pointer);
+    }
+
+    // the owner of a block only routes it for reuse, once the thread is exiting it's freed for good
+    if (s_tl_block_cache_destroyed) {
+        return destroy_block(header_of(pointer));
+    }
+
+    s_tl_block_cache.deallocate(header_of(pointer));
+}
+
+task_allocation_stats task_allocator::stats() noexcept {
+    return block_cache_registry::instance().stats();
+}
+
+void* coroutine_frame_allocator::allocate(size_t size) {
+    return task_allocator::allocate(size);
+}
+
+void coroutine_frame_allocator::deallocate(void* pointer, size_t size) noexcept {
+    task_allocator::deallocate(pointer, size);
+}
@@ -0,0 +1,160 @@
+#include "concurrencpp/threads/thread.h"
+#include "concurrencpp/threads/numa_topology.h"
+
+#include "concurrencpp/platform_defs.h"
+
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+#include <cstdlib>
+
+using concurrencpp::details::numa_node;
+using concurrencpp::details::numa_topology;
+
+namespace concurrencpp::details {
+    namespace {
+        std::vector<numa_node> single_node_topology() {
+            numa_node node {0, {}};
+            const auto cpu_count = thread::hardware_concurrency();
+            node.cpus.reserve(cpu_count);
+
+            for (size_t i = 0; i < cpu_count; i++) {
+                node.cpus.emplace_back(i);
+            }
+
+            return {std::move(node)};
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+numa_topology::numa_topology(std::vector<numa_node> nodes) : m_nodes(std::move(nodes)) {
+    std::sort(m_nodes.begin(), m_nodes.end(), [](const auto& a, const auto& b) {
+        return a.id < b.id;
+    });
+
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        for (const auto cpu : m_nodes[i].cpus) {
+            if (cpu >= m_cpu_to_node.size()) {
+                m_cpu_to_node.resize(cpu + 1, static_cast<size_t>(-1));
+            }
+
+            m_cpu_to_node[cpu] = i;
+        }
+    }
+}
+
+const numa_topology& numa_topology::system() {
+    static const numa_topology s_topology(detect_nodes());
+    return s_topology;
+}
+
+std::vector<size_t> numa_topology::parse_cpu_list(const char* cpu_list) {
+    // a comma separated list of cpus and cpu ranges, e.g. "0-3,8,10-11"
+    std::vector<size_t> cpus;
+
+    while (*cpu_list != '\0') {
+        char* end = nullptr;
+        const auto first = std::strtoul(cpu_list, &end, 10);
+        if (end == cpu_list) {
+            break;
+        }
+
+        auto last = first;
+        if (*end == '-') {
+            cpu_list = end + 1;
+            last = std::strtoul(cpu_list, &end, 10);
+            if (end == cpu_list || last < first) {
+                break;
+            }
+        }
+
+        for (auto cpu = first; cpu <= last; cpu++) {
+            cpus.emplace_back(static_cast<size_t>(cpu));
+        }
+
+        cpu_list = end;
+        if (*cpu_list != ',') {
+            break;
+        }
+
+        ++cpu_list;
+    }
+
+    return cpus;
+}
+
+#if defined(CRCPP_UNIX_OS) && defined(__linux__)
+
+std::vector<numa_node> numa_topology::detect_nodes() {
+    namespace fs = std::filesystem;
+
+    std::vector<numa_node> nodes;
+    std::error_code ec;
+
+    // sysfs entries may vanish or be unreadable while iterating, the non-throwing increment reports that through ec
+    for (fs::directory_iterator it("/sys/devices/system/node", ec), end; !ec && it != end; it.increment(ec)) {
+        const auto& entry = *it;
+        const auto file_name = entry.path().filename().string();
+        if (file_name.size() <= 4 || file_name.compare(0, 4, "node") != 0 ||
+            !std::all_of(file_name.begin() + 4, file_name.end(), [](char c) {
+                return c >= '0' && c <= '9';
+            })) {
+            continue;
+        }
+
+        std::ifstream cpu_list_file(entry.path() / "cpulist");
+        std::string cpu_list;
+        if (!std::getline(cpu_list_file, cpu_list)) {
+            continue;
+        }
+
+        auto cpus = parse_cpu_list(cpu_list.c_str());
+        if (cpus.empty()) {
+            continue;  // memory-only node
+        }
+
+        nodes.emplace_back(numa_node {static_cast<size_t>(std::stoul(file_name.substr(4))), std::move(cpus)});
+    }
+
+    if (ec || nodes.empty()) {
+        return single_node_topology();
+    }
+
+    return nodes;
+}
+
+#else
+
+std::vector<numa_node> numa_topology::detect_nodes() {
+    return single_node_topology();
+}
+
+#endif
+
+const std::vector<numa_node>& numa_topology::nodes() const noexcept {
+    return m_nodes;
+}
+
+size_t numa_topology::index_of_node(size_t node_id) const noexcept {
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        if (m_nodes[i].id == node_id) {
+            return i;
+        }
+    }
+
+    return static_cast<size_t>(-1);
+}
+
+size_t numa_topology::node_index_of_cpu(size_t cpu) const noexcept {
+    return (cpu < m_cpu_to_node.size()) ? m_cpu_to_node[cpu] : static_cast<size_t>(-1);
+}
+
+size_t numa_topology::current_node_index() const noexcept {
+    if (m_nodes.size() == 1) {
+        return 0;
+    }
+
+    return node_index_of_cpu(thread::current_cpu());
+}
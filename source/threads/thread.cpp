@@ -37,6 +37,22 @@ void thread::join() {
     m_thread.join();
 }
 
+void thread::on_thread_start(std::string_view name, const executor_thread_options& options) {
+    if (!options.cpu_affinity.empty()) {
+        set_affinity(options.cpu_affinity);
+    }
+
+    if (static_cast<bool>(options.on_thread_start)) {
+        options.on_thread_start(name);
+    }
+}
+
+void thread::on_thread_stop(std::string_view name, const executor_thread_options& options) {
+    if (static_cast<bool>(options.on_thread_stop)) {
+        options.on_thread_stop(name);
+    }
+}
+
 size_t thread::hardware_concurrency() noexcept {
     const auto hc = std::thread::hardware_concurrency();
     return (hc != 0) ? hc : consts::k_default_number_of_cores;
@@ -52,14 +68,64 @@ void thread::set_name(std::string_view name) noexcept {
     ::SetThreadDescription(::GetCurrentThread(), utf16_name.data());
 }
 
+bool thread::set_affinity(std::span<const size_t> cpus) noexcept {
+    DWORD_PTR mask = 0;
+    for (const auto cpu : cpus) {
+        if (cpu < sizeof(DWORD_PTR) * 8) {  // the first processor group only
+            mask |= (DWORD_PTR(1) << cpu);
+        }
+    }
+
+    return (mask != 0) && (::SetThreadAffinityMask(::GetCurrentThread(), mask) != 0);
+}
+
+size_t thread::current_cpu() noexcept {
+    return static_cast<size_t>(::GetCurrentProcessorNumber());
+}
+
 #elif defined(CRCPP_UNIX_OS)
 
 #    include <pthread.h>
+#    include <sched.h>
 
 void thread::set_name(std::string_view name) noexcept {
     ::pthread_setname_np(::pthread_self(), name.data());
 }
 
+#    if defined(__linux__)
+
+bool thread::set_affinity(std::span<const size_t> cpus) noexcept {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    auto any_cpu = false;
+    for (const auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpu_set);
+            any_cpu = true;
+        }
+    }
+
+    return any_cpu && (::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set) == 0);
+}
+
+size_t thread::current_cpu() noexcept {
+    const auto cpu = ::sched_getcpu();
+    return (cpu >= 0) ? static_cast<size_t>(cpu) : static_cast<size_t>(-1);
+}
+
+#    else
+
+bool thread::set_affinity(std::span<const size_t>) noexcept {
+    return false;
+}
+
+size_t thread::current_cpu() noexcept {
+    return static_cast<size_t>(-1);
+}
+
+#    endif
+
 #elif defined(CRCPP_MAC_OS)
 
 #    include <pthread.h>
@@ -68,4 +134,12 @@ void thread::set_name(std::string_view name) noexcept {
     ::pthread_setname_np(name.data());
 }
 
+bool thread::set_affinity(std::span<const size_t>) noexcept {
+    return false;  // macOS only supports affinity hints
+}
+
+size_t thread::current_cpu() noexcept {
+    return static_cast<size_t>(-1);
+}
+
 #endif
@@ -0,0 +1,133 @@
+#include "concurrencpp/concurrencpp.h"
+#include "concurrencpp/task_allocator.h"
+#include "concurrencpp/executors/impl/mpsc_task_queue.h"
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+/*
+    Compares mpsc_task_queue (the public queue of thread_pool_executor and worker_thread_executor) with the
+    mutex protected deque it replaced, with several producers and a single consumer that drains everything at once.
+    The queue nodes come from the task_allocator pool, the allocation stats show how many of them reached the global allocator.
+    Not a test: build the mpsc_queue_benchmark target in release mode and run it manually.
+*/
+
+namespace concurrencpp::benchmarks {
+    class locked_task_queue {
+
+       private:
+        std::mutex m_lock;
+        std::deque<task> m_tasks;
+
+       public:
+        void push(task& task) {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_tasks.emplace_back(std::move(task));
+        }
+
+        size_t pop_all(std::deque<task>& destination) {
+            std::unique_lock<std::mutex> lock(m_lock);
+            const auto count = m_tasks.size();
+            while (!m_tasks.empty()) {
+                destination.emplace_back(std::move(m_tasks.front()));
+                m_tasks.pop_front();
+            }
+
+            return count;
+        }
+    };
+
+    // every producer keeps at most max_in_flight of its tasks queued, like a client that waits for its results
+    template<class queue_type>
+    double run(queue_type& queue, size_t producer_count, size_t tasks_per_producer, size_t max_in_flight) {
+        std::vector<std::atomic_size_t> executed(producer_count);
+        std::atomic_bool start = false;
+        std::vector<std::thread> producers;
+
+        for (size_t i = 0; i < producer_count; i++) {
+            producers.emplace_back([&, i] {
+                auto& executed_by_producer = executed[i];
+
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+
+                for (size_t j = 0; j < tasks_per_producer; j++) {
+                    while (j - executed_by_producer.load(std::memory_order_relaxed) >= max_in_flight) {
+                        std::this_thread::yield();
+                    }
+
+                    task task([&executed_by_producer] {
+                        executed_by_producer.fetch_add(1, std::memory_order_relaxed);
+                    });
+
+                    queue.push(task);
+                }
+            });
+        }
+
+        const auto total = producer_count * tasks_per_producer;
+        const auto start_time = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+
+        std::deque<task> batch;
+        size_t consumed = 0;
+        while (consumed != total) {
+            const auto popped = queue.pop_all(batch);
+            if (popped == 0) {
+                std::this_thread::yield();
+            }
+
+            consumed += popped;
+
+            while (!batch.empty()) {
+                batch.front()();
+                batch.pop_front();
+            }
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        return std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    }
+}  // namespace concurrencpp::benchmarks
+
+int main() {
+    using namespace concurrencpp::benchmarks;
+    using concurrencpp::details::task_allocator;
+
+    constexpr size_t tasks_per_producer = 1'000'000;
+    constexpr size_t rounds = 3;
+
+    for (size_t round = 0; round < rounds; round++) {
+        std::cout << "round " << round << std::endl;
+
+        for (const size_t max_in_flight : {64, 1'000'000}) {
+            for (const size_t producer_count : {1, 4}) {
+                locked_task_queue locked_queue;
+                const auto locked_time = run(locked_queue, producer_count, tasks_per_producer, max_in_flight);
+
+                const auto stats_before = task_allocator::stats();
+                concurrencpp::details::mpsc_task_queue mpsc_queue;
+                const auto mpsc_time = run(mpsc_queue, producer_count, tasks_per_producer, max_in_flight);
+                const auto stats_after = task_allocator::stats();
+
+                std::cout << "  " << producer_count << " producer(s), " << max_in_flight
+                          << " tasks in flight - locked deque: " << locked_time << " ms, mpsc_task_queue: " << mpsc_time
+                          << " ms (node allocations: " << stats_after.hit_count - stats_before.hit_count << " pooled, "
+                          << stats_after.miss_count - stats_before.miss_count << " global)" << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
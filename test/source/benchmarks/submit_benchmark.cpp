@@ -0,0 +1,121 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+
+/*
+    Compares executor::submit with the coroutine bridge it used to be implemented with, and
+    thread_pool_executor::submit(task_priority, ...) with the single element bulk_submit it used to be implemented with.
+    Not a test: build the submit_benchmark target in release mode and run it manually.
+*/
+
+namespace concurrencpp::benchmarks {
+    template<class callable_type>
+    result<std::invoke_result_t<callable_type>> submit_bridge(executor_tag, executor&, callable_type callable) {
+        co_return callable();
+    }
+
+    template<class callable_type>
+    double measure_ms(callable_type&& callable) {
+        const auto start = std::chrono::steady_clock::now();
+        callable();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    size_t run_inline(executor& executor, size_t iterations, bool use_bridge) {
+        size_t sum = 0;
+        for (size_t i = 0; i < iterations; i++) {
+            auto callable = [i] {
+                return i;
+            };
+
+            sum += use_bridge ? submit_bridge({}, executor, callable).get() : executor.submit(callable).get();
+        }
+
+        return sum;
+    }
+
+    size_t run_batched(executor& executor, size_t iterations, bool use_bridge) {
+        std::vector<result<size_t>> results;
+        results.reserve(iterations);
+
+        for (size_t i = 0; i < iterations; i++) {
+            auto callable = [i] {
+                return i;
+            };
+
+            results.emplace_back(use_bridge ? submit_bridge({}, executor, callable) : executor.submit(callable));
+        }
+
+        size_t sum = 0;
+        for (auto& result : results) {
+            sum += result.get();
+        }
+
+        return sum;
+    }
+
+    size_t run_prioritized(thread_pool_executor& executor, size_t iterations, bool use_bridge) {
+        std::vector<result<size_t>> results;
+        results.reserve(iterations);
+
+        for (size_t i = 0; i < iterations; i++) {
+            auto callable = [i] {
+                return i;
+            };
+
+            if (use_bridge) {
+                auto bridged = executor.bulk_submit<decltype(callable)>(task_priority::high, std::span(&callable, 1));
+                results.emplace_back(std::move(bridged[0]));
+            } else {
+                results.emplace_back(executor.submit(task_priority::high, callable));
+            }
+        }
+
+        size_t sum = 0;
+        for (auto& result : results) {
+            sum += result.get();
+        }
+
+        return sum;
+    }
+}  // namespace concurrencpp::benchmarks
+
+int main() {
+    using namespace concurrencpp::benchmarks;
+
+    constexpr size_t iterations = 1'000'000;
+    constexpr size_t rounds = 3;
+
+    concurrencpp::runtime runtime;
+    auto& inline_executor = *runtime.inline_executor();
+    auto& thread_pool_executor = *runtime.thread_pool_executor();
+
+    size_t sink = 0;
+    for (size_t round = 0; round < rounds; round++) {
+        std::cout << "round " << round << std::endl;
+
+        for (const auto use_bridge : {true, false}) {
+            const auto name = use_bridge ? "bridge" : "submit";
+
+            const auto inline_time = measure_ms([&] {
+                sink += run_inline(inline_executor, iterations, use_bridge);
+            });
+
+            const auto pool_time = measure_ms([&] {
+                sink += run_batched(thread_pool_executor, iterations, use_bridge);
+            });
+
+            const auto prioritized_time = measure_ms([&] {
+                sink += run_prioritized(thread_pool_executor, iterations, use_bridge);
+            });
+
+            std::cout << "  " << name << " - inline_executor: " << inline_time << " ms, thread_pool_executor: " << pool_time
+                      << " ms, thread_pool_executor (task_priority::high): " << prioritized_time << " ms" << std::endl;
+        }
+    }
+
+    return sink == 0 ? 1 : 0;
+}
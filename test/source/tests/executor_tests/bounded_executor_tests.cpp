@@ -0,0 +1,516 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/object_observer.h"
+#include "utils/custom_exception.h"
+#include "utils/executor_shutdowner.h"
+
+#include <deque>
+
+namespace concurrencpp::tests {
+    void test_bounded_executor_name();
+    void test_bounded_executor_constructor();
+    void test_bounded_executor_shutdown();
+    void test_bounded_executor_max_concurrency_level();
+
+    void test_bounded_executor_throw_policy();
+    void test_bounded_executor_drop_oldest_policy();
+    void test_bounded_executor_block_policy();
+    void test_bounded_executor_post_async();
+    void test_bounded_executor_post_async_shutdown();
+    void test_bounded_executor_post_async_underlying_shutdown();
+    void test_bounded_executor_post_async_underlying_error();
+    void test_bounded_executor_underlying_drops_runners();
+}  // namespace concurrencpp::tests
+
+using concurrencpp::inline_executor;
+using concurrencpp::manual_executor;
+using concurrencpp::bounded_executor;
+using concurrencpp::queue_full_policy;
+
+namespace concurrencpp::tests {
+    result<void> post_async_twice(std::shared_ptr<bounded_executor> executor,
+                                  std::shared_ptr<concurrencpp::executor> resume_executor,
+                                  object_observer& observer,
+                                  std::atomic_size_t& admitted_count) {
+        co_await executor->post_async(resume_executor, observer.get_testing_stub());
+        admitted_count.fetch_add(1);
+
+        co_await executor->post_async(resume_executor, observer.get_testing_stub());
+        admitted_count.fetch_add(1);
+    }
+
+    // a single threaded executor that can be told to reject new tasks while it still executes the queued ones
+    class rejecting_executor final : public derivable_executor<rejecting_executor> {
+
+       private:
+        std::deque<task> m_tasks;
+
+       public:
+        bool reject = false;
+        bool fail = false;
+
+        rejecting_executor() : derivable_executor<rejecting_executor>("rejecting_executor") {}
+
+        void enqueue(task task) override {
+            if (reject) {
+                concurrencpp::details::throw_runtime_shutdown_exception(name);
+            }
+
+            if (fail) {
+                throw custom_exception(0);
+            }
+
+            m_tasks.emplace_back(std::move(task));
+        }
+
+        void enqueue(std::span<task> tasks) override {
+            for (auto& task : tasks) {
+                enqueue(std::move(task));
+            }
+        }
+
+        int max_concurrency_level() const noexcept override {
+            return 1;
+        }
+
+        bool shutdown_requested() const noexcept override {
+            return reject;
+        }
+
+        void shutdown() noexcept override {
+            reject = true;
+        }
+
+        bool loop_once() {
+            if (m_tasks.empty()) {
+                return false;
+            }
+
+            auto task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            task();
+            return true;
+        }
+    };
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_bounded_executor_name() {
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 4, queue_full_policy::throw_exception);
+    executor_shutdowner shutdown(executor);
+
+    assert_equal(executor->name, concurrencpp::details::consts::k_bounded_executor_name);
+}
+
+void concurrencpp::tests::test_bounded_executor_constructor() {
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            bounded_executor executor({}, 4, queue_full_policy::block);
+        },
+        concurrencpp::details::consts::k_bounded_executor_null_executor_err_msg);
+
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [underlying_executor] {
+            bounded_executor executor(underlying_executor, 0, queue_full_policy::block);
+        },
+        concurrencpp::details::consts::k_bounded_executor_invalid_capacity_err_msg);
+
+    bounded_executor executor(underlying_executor, 4, queue_full_policy::drop_oldest);
+    assert_equal(executor.underlying_executor(), std::static_pointer_cast<concurrencpp::executor>(underlying_executor));
+    assert_equal(executor.capacity(), static_cast<size_t>(4));
+    assert_true(executor.policy() == queue_full_policy::drop_oldest);
+    assert_equal(executor.size(), static_cast<size_t>(0));
+    assert_equal(executor.dropped_task_count(), static_cast<size_t>(0));
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&executor] {
+            executor.post_async({}, [] {});
+        },
+        concurrencpp::details::consts::k_bounded_executor_null_resume_executor_err_msg);
+}
+
+void concurrencpp::tests::test_bounded_executor_shutdown() {
+    object_observer observer;
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 4, queue_full_policy::throw_exception);
+    assert_false(executor->shutdown_requested());
+
+    auto result = executor->submit(observer.get_testing_stub());
+
+    executor->shutdown();
+    executor->shutdown();
+    assert_true(executor->shutdown_requested());
+    assert_false(underlying_executor->shutdown_requested());
+
+    // the queued task is dropped, its runner does nothing
+    assert_throws<concurrencpp::errors::broken_task>([&result] {
+        result.get();
+    });
+
+    assert_equal(underlying_executor->loop(100), static_cast<size_t>(1));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        executor->enqueue(concurrencpp::task {});
+    });
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        concurrencpp::task array[4];
+        std::span<concurrencpp::task> span = array;
+        executor->enqueue(span);
+    });
+}
+
+void concurrencpp::tests::test_bounded_executor_max_concurrency_level() {
+    auto underlying_executor = std::make_shared<concurrencpp::thread_pool_executor>("bounded pool", 3, std::chrono::seconds(10));
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 4, queue_full_policy::block);
+    executor_shutdowner shutdown(executor);
+
+    assert_equal(executor->max_concurrency_level(), 3);
+}
+
+void concurrencpp::tests::test_bounded_executor_throw_policy() {
+    object_observer observer;
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 2, queue_full_policy::throw_exception);
+    executor_shutdowner shutdown(executor);
+
+    executor->post(observer.get_testing_stub());
+    executor->post(observer.get_testing_stub());
+    assert_equal(executor->size(), static_cast<size_t>(2));
+
+    assert_throws_with_error_message<concurrencpp::errors::queue_full>(
+        [executor, &observer] {
+            executor->post(observer.get_testing_stub());
+        },
+        concurrencpp::details::consts::k_bounded_executor_queue_full_err_msg);
+
+    assert_equal(underlying_executor->loop_once(), true);
+    assert_equal(executor->size(), static_cast<size_t>(1));
+
+    // a batch is admitted as a whole or not at all
+    std::vector<testing_stub> stubs;
+    stubs.emplace_back(observer.get_testing_stub());
+    stubs.emplace_back(observer.get_testing_stub());
+
+    assert_throws<concurrencpp::errors::queue_full>([executor, &stubs] {
+        executor->bulk_post<testing_stub>(stubs);
+    });
+
+    assert_equal(executor->size(), static_cast<size_t>(1));
+
+    // the rejected batch was already moved into tasks
+    stubs.clear();
+    stubs.emplace_back(observer.get_testing_stub());
+    executor->bulk_post<testing_stub>(stubs);
+    assert_equal(executor->size(), static_cast<size_t>(2));
+
+    assert_equal(underlying_executor->loop(100), static_cast<size_t>(2));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(3));
+    assert_equal(executor->size(), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_bounded_executor_drop_oldest_policy() {
+    object_observer observer;
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 2, queue_full_policy::drop_oldest);
+    executor_shutdowner shutdown(executor);
+
+    std::vector<result<size_t>> results;
+    for (size_t i = 0; i < 5; i++) {
+        results.emplace_back(executor->submit(observer.get_testing_stub(i)));
+    }
+
+    assert_equal(executor->size(), static_cast<size_t>(2));
+    assert_equal(executor->dropped_task_count(), static_cast<size_t>(3));
+
+    // dropping a task doesn't add a runner to the underlying executor
+    assert_equal(underlying_executor->size(), static_cast<size_t>(2));
+    assert_equal(underlying_executor->loop(100), static_cast<size_t>(2));
+
+    for (size_t i = 0; i < 3; i++) {
+        assert_throws<concurrencpp::errors::broken_task>([&results, i] {
+            results[i].get();
+        });
+    }
+
+    assert_equal(results[3].get(), static_cast<size_t>(3));
+    assert_equal(results[4].get(), static_cast<size_t>(4));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(2));
+}
+
+void concurrencpp::tests::test_bounded_executor_block_policy() {
+    object_observer observer;
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 1, queue_full_policy::block);
+    executor_shutdowner shutdown(executor);
+
+    executor->post(observer.get_testing_stub());
+
+    std::atomic_bool posted = false;
+    std::thread producer([&] {
+        executor->post(observer.get_testing_stub());
+        posted = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert_false(posted.load());
+
+    assert_true(underlying_executor->loop_once());
+    producer.join();
+    assert_true(posted.load());
+
+    assert_equal(underlying_executor->loop(100), static_cast<size_t>(1));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(2));
+
+    // a blocked producer is released by shutdown
+    executor->post(observer.get_testing_stub());
+
+    std::thread blocked_producer([&] {
+        assert_throws<concurrencpp::errors::runtime_shutdown>([&] {
+            executor->post(observer.get_testing_stub());
+        });
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    executor->shutdown();
+    blocked_producer.join();
+}
+
+void concurrencpp::tests::test_bounded_executor_post_async() {
+    object_observer observer;
+    auto resume_executor = std::make_shared<inline_executor>();
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 1, queue_full_policy::throw_exception);
+    executor_shutdowner shutdown(executor);
+
+    std::atomic_size_t admitted_count = 0;
+    auto result = post_async_twice(executor, resume_executor, observer, admitted_count);
+
+    // the first task is admitted right away, the producer is suspended on the second one
+    assert_equal(admitted_count.load(), static_cast<size_t>(1));
+    assert_equal(result.status(), concurrencpp::result_status::idle);
+
+    // a sync producer doesn't fit either, the throwing policy still applies to it
+    assert_throws<concurrencpp::errors::queue_full>([executor] {
+        executor->post([] {});
+    });
+
+    // executing the first task frees its slot for the suspended producer
+    assert_true(underlying_executor->loop_once());
+    assert_equal(admitted_count.load(), static_cast<size_t>(2));
+    result.get();
+
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_equal(underlying_executor->loop(100), static_cast<size_t>(1));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(2));
+}
+
+void concurrencpp::tests::test_bounded_executor_post_async_shutdown() {
+    object_observer observer;
+    auto resume_executor = std::make_shared<inline_executor>();
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 1, queue_full_policy::block);
+
+    std::atomic_size_t admitted_count = 0;
+    auto result = post_async_twice(executor, resume_executor, observer, admitted_count);
+    assert_equal(admitted_count.load(), static_cast<size_t>(1));
+
+    executor->shutdown();
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([&result] {
+        result.get();
+    });
+
+    assert_equal(admitted_count.load(), static_cast<size_t>(1));
+}
+
+void concurrencpp::tests::test_bounded_executor_post_async_underlying_shutdown() {
+    object_observer observer;
+    auto resume_executor = std::make_shared<inline_executor>();
+    auto underlying_executor = std::make_shared<rejecting_executor>();
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 1, queue_full_policy::block);
+
+    std::atomic_size_t admitted_count = 0;
+    auto result = post_async_twice(executor, resume_executor, observer, admitted_count);
+    assert_equal(admitted_count.load(), static_cast<size_t>(1));
+
+    // the runner of the first task can't schedule a runner for the admitted task
+    underlying_executor->reject = true;
+    assert_true(underlying_executor->loop_once());
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([&result] {
+        result.get();
+    });
+
+    assert_equal(admitted_count.load(), static_cast<size_t>(1));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(1));
+    assert_equal(observer.get_destruction_count(), static_cast<size_t>(2));
+
+    // the bounded executor can't execute anything anymore, new tasks are rejected instead of occupying its slots
+    assert_true(executor->shutdown_requested());
+    assert_equal(executor->size(), static_cast<size_t>(0));
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        executor->post([] {});
+    });
+
+    assert_false(underlying_executor->loop_once());
+}
+
+void concurrencpp::tests::test_bounded_executor_post_async_underlying_error() {
+    object_observer observer;
+    auto resume_executor = std::make_shared<inline_executor>();
+    auto underlying_executor = std::make_shared<rejecting_executor>();
+    auto executor = std::make_shared<bounded_executor>(underlying_executor, 1, queue_full_policy::block);
+
+    std::atomic_size_t admitted_count = 0;
+    auto result = post_async_twice(executor, resume_executor, observer, admitted_count);
+    assert_equal(admitted_count.load(), static_cast<size_t>(1));
+
+    // the runner of the first task fails to schedule a runner for the admitted task with a non-shutdown error:
+    // the first task still runs, the error is reported by the runner and the suspended producer is released.
+    underlying_executor->fail = true;
+    assert_throws<custom_exception>([underlying_executor] {
+        underlying_executor->loop_once();
+    });
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([&result] {
+        result.get();
+    });
+
+    assert_equal(admitted_count.load(), static_cast<size_t>(1));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(1));
+    assert_equal(observer.get_destruction_count(), static_cast<size_t>(2));
+
+    assert_true(executor->shutdown_requested());
+    assert_equal(executor->size(), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_bounded_executor_underlying_drops_runners() {
+    // the underlying executor accepts the runners and destroys them without running them,
+    // the queued tasks can never run, so the bounded executor is shut down instead of keeping their slots.
+    {
+        object_observer observer;
+        auto underlying_executor = std::make_shared<manual_executor>();
+        auto executor = std::make_shared<bounded_executor>(underlying_executor, 1, queue_full_policy::throw_exception);
+        executor_shutdowner shutdown(executor);
+
+        executor->post(observer.get_testing_stub());
+        underlying_executor->shutdown();
+
+        assert_true(executor->shutdown_requested());
+        assert_equal(executor->size(), static_cast<size_t>(0));
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor, &observer] {
+            executor->post(observer.get_testing_stub());
+        });
+
+        assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+        assert_equal(observer.get_destruction_count(), static_cast<size_t>(2));
+    }
+
+    {
+        object_observer observer;
+        auto underlying_executor = std::make_shared<manual_executor>();
+        auto executor = std::make_shared<bounded_executor>(underlying_executor, 1, queue_full_policy::drop_oldest);
+        executor_shutdowner shutdown(executor);
+
+        executor->post(observer.get_testing_stub());
+        underlying_executor->shutdown();
+
+        assert_true(executor->shutdown_requested());
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor, &observer] {
+            executor->post(observer.get_testing_stub());
+        });
+
+        assert_equal(executor->dropped_task_count(), static_cast<size_t>(0));
+        assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+    }
+
+    // a producer that is blocked on the full queue is released
+    {
+        object_observer observer;
+        auto underlying_executor = std::make_shared<manual_executor>();
+        auto executor = std::make_shared<bounded_executor>(underlying_executor, 1, queue_full_policy::block);
+        executor_shutdowner shutdown(executor);
+
+        executor->post(observer.get_testing_stub());
+
+        std::thread blocked_producer([&] {
+            assert_throws<concurrencpp::errors::runtime_shutdown>([&] {
+                executor->post(observer.get_testing_stub());
+            });
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        underlying_executor->shutdown();
+        blocked_producer.join();
+
+        assert_true(executor->shutdown_requested());
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor, &observer] {
+            executor->post(observer.get_testing_stub());
+        });
+
+        assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+    }
+
+    // a suspended post_async producer is resumed
+    {
+        object_observer observer;
+        auto resume_executor = std::make_shared<inline_executor>();
+        auto underlying_executor = std::make_shared<manual_executor>();
+        auto executor = std::make_shared<bounded_executor>(underlying_executor, 1, queue_full_policy::block);
+        executor_shutdowner shutdown(executor);
+
+        std::atomic_size_t admitted_count = 0;
+        auto result = post_async_twice(executor, resume_executor, observer, admitted_count);
+        assert_equal(admitted_count.load(), static_cast<size_t>(1));
+
+        underlying_executor->shutdown();
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([&result] {
+            result.get();
+        });
+
+        assert_equal(admitted_count.load(), static_cast<size_t>(1));
+        assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+    }
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("bounded_executor test");
+
+    tester.add_step("name", test_bounded_executor_name);
+    tester.add_step("constructor", test_bounded_executor_constructor);
+    tester.add_step("shutdown", test_bounded_executor_shutdown);
+    tester.add_step("max_concurrency_level", test_bounded_executor_max_concurrency_level);
+    tester.add_step("throw policy", test_bounded_executor_throw_policy);
+    tester.add_step("drop oldest policy", test_bounded_executor_drop_oldest_policy);
+    tester.add_step("block policy", test_bounded_executor_block_policy);
+    tester.add_step("post_async", test_bounded_executor_post_async);
+    tester.add_step("post_async shutdown", test_bounded_executor_post_async_shutdown);
+    tester.add_step("post_async underlying shutdown", test_bounded_executor_post_async_underlying_shutdown);
+    tester.add_step("post_async underlying error", test_bounded_executor_post_async_underlying_error);
+    tester.add_step("underlying executor drops runners", test_bounded_executor_underlying_drops_runners);
+
+    tester.launch_test();
+    return 0;
+}
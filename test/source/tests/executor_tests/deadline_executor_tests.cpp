@@ -0,0 +1,305 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/object_observer.h"
+#include "utils/executor_shutdowner.h"
+
+#include <mutex>
+#include <string>
+
+namespace concurrencpp::tests {
+    void test_deadline_executor_name();
+    void test_deadline_executor_constructor();
+    void test_deadline_executor_shutdown();
+    void test_deadline_executor_max_concurrency_level();
+
+    void test_deadline_executor_post_submit();
+    void test_deadline_executor_earliest_deadline_first();
+    void test_deadline_executor_missed_deadlines();
+    void test_deadline_executor_other_clocks();
+    void test_deadline_executor_stealing();
+}  // namespace concurrencpp::tests
+
+using concurrencpp::deadline_executor;
+using concurrencpp::deadline_miss_policy;
+
+namespace concurrencpp::tests {
+    // occupies a worker until release is called
+    class worker_blocker {
+
+       private:
+        std::atomic_bool m_started = false;
+        std::atomic_bool m_released = false;
+
+       public:
+        void block() noexcept {
+            m_started = true;
+            while (!m_released) {
+                std::this_thread::yield();
+            }
+        }
+
+        void wait_started() const noexcept {
+            while (!m_started) {
+                std::this_thread::yield();
+            }
+        }
+
+        void release() noexcept {
+            m_released = true;
+        }
+    };
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_deadline_executor_name() {
+    auto executor = std::make_shared<deadline_executor>("deadline pool", 2);
+    executor_shutdowner shutdown(executor);
+
+    assert_equal(executor->name, "deadline pool");
+}
+
+void concurrencpp::tests::test_deadline_executor_constructor() {
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            deadline_executor executor("deadline pool", 0);
+        },
+        concurrencpp::details::consts::k_deadline_executor_invalid_pool_size_err_msg);
+}
+
+void concurrencpp::tests::test_deadline_executor_shutdown() {
+    object_observer observer;
+    worker_blocker blocker;
+    auto executor = std::make_shared<deadline_executor>("deadline pool", 1);
+    assert_false(executor->shutdown_requested());
+
+    executor->post([&blocker] {
+        blocker.block();
+    });
+
+    blocker.wait_started();
+
+    auto result = executor->submit_with_deadline(deadline_executor::clock_type::now() + std::chrono::seconds(10),
+                                                 deadline_miss_policy::execute,
+                                                 observer.get_testing_stub());
+
+    std::thread releaser([&blocker] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        blocker.release();
+    });
+
+    executor->shutdown();
+    executor->shutdown();
+    releaser.join();
+
+    assert_true(executor->shutdown_requested());
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+    assert_throws<concurrencpp::errors::broken_task>([&result] {
+        result.get();
+    });
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        executor->enqueue(concurrencpp::task {});
+    });
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        executor->enqueue(concurrencpp::task {}, deadline_executor::clock_type::now());
+    });
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        executor->post_with_deadline(deadline_executor::clock_type::now(), deadline_miss_policy::execute, [] {});
+    });
+}
+
+void concurrencpp::tests::test_deadline_executor_max_concurrency_level() {
+    auto executor = std::make_shared<deadline_executor>("deadline pool", 3);
+    executor_shutdowner shutdown(executor);
+
+    assert_equal(executor->max_concurrency_level(), 3);
+}
+
+void concurrencpp::tests::test_deadline_executor_post_submit() {
+    object_observer observer;
+    constexpr size_t task_count = 256;
+    auto executor = std::make_shared<deadline_executor>("deadline pool", 2);
+    executor_shutdowner shutdown(executor);
+
+    std::vector<result<size_t>> results;
+    for (size_t i = 0; i < task_count; i++) {
+        executor->post(observer.get_testing_stub());
+        results.emplace_back(executor->submit_with_deadline(deadline_executor::clock_type::now() + std::chrono::minutes(1),
+                                                            deadline_miss_policy::execute,
+                                                            observer.get_testing_stub(i)));
+    }
+
+    for (size_t i = 0; i < task_count; i++) {
+        assert_equal(results[i].get(), i);
+    }
+
+    assert_true(observer.wait_execution_count(task_count * 2, std::chrono::minutes(1)));
+    assert_equal(executor->missed_deadline_count(), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_deadline_executor_earliest_deadline_first() {
+    worker_blocker blocker;
+    auto executor = std::make_shared<deadline_executor>("deadline pool", 1);
+    executor_shutdowner shutdown(executor);
+
+    executor->post([&blocker] {
+        blocker.block();
+    });
+
+    blocker.wait_started();
+
+    std::mutex lock;
+    std::string order;
+    auto record = [&lock, &order](char c) {
+        std::unique_lock<std::mutex> guard(lock);
+        order += c;
+    };
+
+    const auto now = deadline_executor::clock_type::now();
+    std::vector<result<void>> results;
+
+    results.emplace_back(executor->submit(record, 'N'));
+    results.emplace_back(executor->submit_with_deadline(now + std::chrono::minutes(3), deadline_miss_policy::execute, record, 'C'));
+    results.emplace_back(executor->submit_with_deadline(now + std::chrono::minutes(1), deadline_miss_policy::execute, record, 'A'));
+    results.emplace_back(executor->submit(record, 'O'));
+    results.emplace_back(executor->submit_with_deadline(now + std::chrono::minutes(2), deadline_miss_policy::execute, record, 'B'));
+    results.emplace_back(executor->submit_with_deadline(now + std::chrono::minutes(2), deadline_miss_policy::execute, record, 'b'));
+
+    blocker.release();
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    // earliest deadline first, equal deadlines and tasks without a deadline in FIFO order
+    assert_equal(order, std::string("ABbCNO"));
+}
+
+void concurrencpp::tests::test_deadline_executor_missed_deadlines() {
+    object_observer observer;
+    worker_blocker blocker;
+    auto executor = std::make_shared<deadline_executor>("deadline pool", 1);
+    executor_shutdowner shutdown(executor);
+
+    executor->post([&blocker] {
+        blocker.block();
+    });
+
+    blocker.wait_started();
+
+    const auto deadline = deadline_executor::clock_type::now() + std::chrono::milliseconds(5);
+    auto executed = executor->submit_with_deadline(deadline, deadline_miss_policy::execute, observer.get_testing_stub(1));
+    auto dropped = executor->submit_with_deadline(deadline, deadline_miss_policy::drop, observer.get_testing_stub(2));
+    auto in_time =
+        executor->submit_with_deadline(deadline + std::chrono::minutes(1), deadline_miss_policy::drop, observer.get_testing_stub(3));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    blocker.release();
+
+    assert_equal(executed.get(), static_cast<size_t>(1));
+    assert_equal(in_time.get(), static_cast<size_t>(3));
+    assert_throws<concurrencpp::errors::broken_task>([&dropped] {
+        dropped.get();
+    });
+
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(2));
+    assert_equal(executor->missed_deadline_count(), static_cast<size_t>(2));
+    assert_equal(executor->dropped_task_count(), static_cast<size_t>(1));
+}
+
+void concurrencpp::tests::test_deadline_executor_other_clocks() {
+    worker_blocker blocker;
+    auto executor = std::make_shared<deadline_executor>("deadline pool", 1);
+    executor_shutdowner shutdown(executor);
+
+    executor->post([&blocker] {
+        blocker.block();
+    });
+
+    blocker.wait_started();
+
+    auto late = executor->submit_with_deadline(std::chrono::system_clock::now() + std::chrono::minutes(2),
+                                               deadline_miss_policy::execute,
+                                               [] {
+                                                   return 2;
+                                               });
+    auto early = executor->submit_with_deadline(std::chrono::steady_clock::now() + std::chrono::minutes(1),
+                                                deadline_miss_policy::execute,
+                                                [&late] {
+                                                    // late hasn't run yet
+                                                    return late.status() == concurrencpp::result_status::idle;
+                                                });
+
+    blocker.release();
+
+    assert_true(early.get());
+    assert_equal(late.get(), 2);
+
+    // time_point::max() of another clock is a "no deadline" sentinel, it must not overflow into an early deadline
+    worker_blocker sentinel_blocker;
+    executor->post([&sentinel_blocker] {
+        sentinel_blocker.block();
+    });
+
+    sentinel_blocker.wait_started();
+
+    auto unbounded = executor->submit_with_deadline(std::chrono::system_clock::time_point::max(),
+                                                    deadline_miss_policy::execute,
+                                                    [] {
+                                                        return 3;
+                                                    });
+    auto bounded = executor->submit_with_deadline(std::chrono::steady_clock::now() + std::chrono::hours(24),
+                                                  deadline_miss_policy::execute,
+                                                  [&unbounded] {
+                                                      return unbounded.status() == concurrencpp::result_status::idle;
+                                                  });
+
+    sentinel_blocker.release();
+
+    assert_true(bounded.get());
+    assert_equal(unbounded.get(), 3);
+}
+
+void concurrencpp::tests::test_deadline_executor_stealing() {
+    object_observer observer;
+    constexpr size_t task_count = 64;
+    worker_blocker blocker;
+    auto executor = std::make_shared<deadline_executor>("deadline pool", 2);
+    executor_shutdowner shutdown(executor);
+
+    // tasks enqueued by a worker go to its own heap, the blocked worker can't execute them so they must be stolen
+    executor->post([executor, &observer, &blocker] {
+        for (size_t i = 0; i < task_count; i++) {
+            executor->post_with_deadline(deadline_executor::clock_type::now() + std::chrono::minutes(1),
+                                         deadline_miss_policy::execute,
+                                         observer.get_testing_stub());
+        }
+
+        blocker.block();
+    });
+
+    assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+    blocker.release();
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("deadline_executor test");
+
+    tester.add_step("name", test_deadline_executor_name);
+    tester.add_step("constructor", test_deadline_executor_constructor);
+    tester.add_step("shutdown", test_deadline_executor_shutdown);
+    tester.add_step("max_concurrency_level", test_deadline_executor_max_concurrency_level);
+    tester.add_step("post and submit", test_deadline_executor_post_submit);
+    tester.add_step("earliest deadline first", test_deadline_executor_earliest_deadline_first);
+    tester.add_step("missed deadlines", test_deadline_executor_missed_deadlines);
+    tester.add_step("other clocks", test_deadline_executor_other_clocks);
+    tester.add_step("stealing", test_deadline_executor_stealing);
+
+    tester.launch_test();
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/object_observer.h"
+#include "utils/executor_shutdowner.h"
+
+#include <string>
+
+namespace concurrencpp::tests {
+    void test_keyed_executor_name();
+    void test_keyed_executor_constructor();
+    void test_keyed_executor_shutdown();
+    void test_keyed_executor_max_concurrency_level();
+
+    void test_keyed_executor_lanes();
+    void test_keyed_executor_queue_depths();
+    void test_keyed_executor_per_key_order();
+    void test_keyed_executor_unkeyed_enqueue();
+}  // namespace concurrencpp::tests
+
+using concurrencpp::keyed_executor;
+using concurrencpp::manual_executor;
+using concurrencpp::thread_pool_executor;
+
+void concurrencpp::tests::test_keyed_executor_name() {
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<keyed_executor>(underlying_executor, 4);
+    executor_shutdowner shutdown(executor);
+
+    assert_equal(executor->name, concurrencpp::details::consts::k_keyed_executor_name);
+}
+
+void concurrencpp::tests::test_keyed_executor_constructor() {
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            keyed_executor executor({}, 4);
+        },
+        concurrencpp::details::consts::k_keyed_executor_null_executor_err_msg);
+
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [underlying_executor] {
+            keyed_executor executor(underlying_executor, 0);
+        },
+        concurrencpp::details::consts::k_keyed_executor_invalid_lane_count_err_msg);
+
+    keyed_executor executor(underlying_executor, 8, 16);
+    assert_equal(executor.lane_count(), static_cast<size_t>(8));
+    assert_equal(executor.underlying_executor(), std::static_pointer_cast<concurrencpp::executor>(underlying_executor));
+
+    for (size_t i = 0; i < executor.lane_count(); i++) {
+        assert_equal(executor.lane(i)->max_batch_size(), static_cast<size_t>(16));
+        assert_equal(executor.lane(i)->underlying_executor(), std::static_pointer_cast<concurrencpp::executor>(underlying_executor));
+    }
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&executor] {
+            executor.lane(8);
+        },
+        concurrencpp::details::consts::k_keyed_executor_invalid_lane_err_msg);
+}
+
+void concurrencpp::tests::test_keyed_executor_shutdown() {
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<keyed_executor>(underlying_executor, 4);
+    assert_false(executor->shutdown_requested());
+
+    executor->shutdown();
+    executor->shutdown();
+    assert_true(executor->shutdown_requested());
+    assert_false(underlying_executor->shutdown_requested());
+
+    for (size_t i = 0; i < executor->lane_count(); i++) {
+        assert_true(executor->lane(i)->shutdown_requested());
+    }
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        executor->enqueue(concurrencpp::task {});
+    });
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        executor->post(1, [] {});
+    });
+
+    // a lane that can't be scheduled anymore shuts itself down, the keyed executor reports it
+    {
+        auto underlying_executor = std::make_shared<manual_executor>();
+        auto executor = std::make_shared<keyed_executor>(underlying_executor, 4);
+        executor_shutdowner shutdown(executor);
+
+        executor->post(1, [] {});
+        assert_false(executor->shutdown_requested());
+
+        underlying_executor->shutdown();
+        assert_true(executor->shutdown_requested());
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+            executor->enqueue(concurrencpp::task {});
+        });
+    }
+}
+
+void concurrencpp::tests::test_keyed_executor_max_concurrency_level() {
+    auto underlying_executor = std::make_shared<thread_pool_executor>("keyed pool", 2, std::chrono::seconds(10));
+    executor_shutdowner underlying_shutdown(underlying_executor);
+
+    auto executor = std::make_shared<keyed_executor>(underlying_executor, 4);
+    executor_shutdowner shutdown(executor);
+    assert_equal(executor->max_concurrency_level(), 2);
+
+    auto narrow_executor = std::make_shared<keyed_executor>(underlying_executor, 1);
+    executor_shutdowner narrow_shutdown(narrow_executor);
+    assert_equal(narrow_executor->max_concurrency_level(), 1);
+}
+
+void concurrencpp::tests::test_keyed_executor_lanes() {
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<keyed_executor>(underlying_executor, 16);
+    executor_shutdowner shutdown(executor);
+
+    std::vector<size_t> keys_per_lane(executor->lane_count(), 0);
+    for (size_t key = 0; key < 1'024; key++) {
+        const auto lane = executor->lane_of(key);
+        assert_true(lane < executor->lane_count());
+        assert_equal(executor->lane_of(key), lane);
+        ++keys_per_lane[lane];
+    }
+
+    // consecutive keys are spread over all the lanes
+    for (const auto key_count : keys_per_lane) {
+        assert_true(key_count > 0);
+    }
+
+    const std::string string_key = "account-42";
+    assert_equal(executor->lane_of(string_key), executor->lane_of(std::string("account-42")));
+}
+
+void concurrencpp::tests::test_keyed_executor_queue_depths() {
+    object_observer observer;
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<keyed_executor>(underlying_executor, 4);
+    executor_shutdowner shutdown(executor);
+
+    const size_t key = 7;
+    const auto lane = executor->lane_of(key);
+
+    for (size_t i = 0; i < 10; i++) {
+        executor->post(key, observer.get_testing_stub());
+    }
+
+    const auto depths = executor->queue_depths();
+    assert_equal(depths.size(), executor->lane_count());
+
+    for (size_t i = 0; i < depths.size(); i++) {
+        assert_equal(depths[i], (i == lane) ? static_cast<size_t>(10) : static_cast<size_t>(0));
+        assert_equal(executor->queue_depth(i), depths[i]);
+    }
+
+    underlying_executor->loop(100);
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(10));
+    assert_equal(executor->queue_depth(lane), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_keyed_executor_per_key_order() {
+    constexpr size_t key_count = 8;
+    constexpr size_t task_count = 512;
+
+    auto underlying_executor = std::make_shared<thread_pool_executor>("keyed pool", 4, std::chrono::seconds(10));
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<keyed_executor>(underlying_executor, 4);
+    executor_shutdowner shutdown(executor);
+
+    std::vector<size_t> last_seen(key_count, 0);
+    std::atomic_bool in_order = true;
+    std::vector<result<void>> results;
+
+    for (size_t i = 1; i <= task_count; i++) {
+        for (size_t key = 0; key < key_count; key++) {
+            results.emplace_back(executor->submit(key, [&, key, i] {
+                // not synchronized, tasks of the same key never run concurrently
+                if (last_seen[key] + 1 != i) {
+                    in_order = false;
+                }
+
+                last_seen[key] = i;
+            }));
+        }
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_true(in_order.load());
+    for (const auto seen : last_seen) {
+        assert_equal(seen, task_count);
+    }
+}
+
+void concurrencpp::tests::test_keyed_executor_unkeyed_enqueue() {
+    object_observer observer;
+    constexpr size_t task_count = 64;
+
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<keyed_executor>(underlying_executor, 4);
+    executor_shutdowner shutdown(executor);
+
+    std::vector<value_testing_stub> stubs;
+    for (size_t i = 0; i < task_count; i++) {
+        stubs.emplace_back(observer.get_testing_stub(i));
+    }
+
+    // the keyed overloads hide the unkeyed ones, which remain accessible through the executor interface
+    std::shared_ptr<concurrencpp::executor> base_executor = executor;
+    base_executor->bulk_post<value_testing_stub>(stubs);
+    auto result = base_executor->submit(observer.get_testing_stub(task_count));
+
+    // unkeyed tasks are spread over the lanes
+    for (const auto depth : executor->queue_depths()) {
+        assert_true(depth > 0);
+    }
+
+    underlying_executor->loop(1'024);
+    assert_equal(observer.get_execution_count(), task_count + 1);
+    assert_equal(result.get(), task_count);
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("keyed_executor test");
+
+    tester.add_step("name", test_keyed_executor_name);
+    tester.add_step("constructor", test_keyed_executor_constructor);
+    tester.add_step("shutdown", test_keyed_executor_shutdown);
+    tester.add_step("max_concurrency_level", test_keyed_executor_max_concurrency_level);
+    tester.add_step("lanes", test_keyed_executor_lanes);
+    tester.add_step("queue depths", test_keyed_executor_queue_depths);
+    tester.add_step("per key order", test_keyed_executor_per_key_order);
+    tester.add_step("unkeyed enqueue", test_keyed_executor_unkeyed_enqueue);
+
+    tester.launch_test();
+    return 0;
+}
@@ -7,6 +7,10 @@
 #include "utils/test_ready_result.h"
 #include "utils/executor_shutdowner.h"
 
+#if defined(CRCPP_UNIX_OS) && defined(__linux__)
+#    include <poll.h>
+#endif
+
 namespace concurrencpp::tests {
     void test_manual_executor_name();
 
@@ -24,6 +28,7 @@ namespace concurrencpp::tests {
     void test_manual_executor_submit_exception();
     void test_manual_executor_submit_foreign();
     void test_manual_executor_submit_inline();
+    void test_manual_executor_submit_unexecuted();
     void test_manual_executor_submit();
 
     void test_manual_executor_bulk_post_exception();
@@ -45,6 +50,9 @@ namespace concurrencpp::tests {
     void test_manual_executor_loop_until();
 
     void test_manual_executor_clear();
+    void test_manual_executor_drain();
+    void test_manual_executor_loop_throwing_task();
+    void test_manual_executor_wakeup_fd();
 
     void test_manual_executor_wait_for_task();
     void test_manual_executor_wait_for_task_for();
@@ -88,6 +96,10 @@ void concurrencpp::tests::test_manual_executor_shutdown_method_access() {
         executor->clear();
     });
 
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        executor->drain();
+    });
+
     assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
         executor->loop_once();
     });
@@ -347,10 +359,53 @@ void concurrencpp::tests::test_manual_executor_submit_inline() {
     assert_equal(observer.get_destruction_count(), task_count);
 }
 
+void concurrencpp::tests::test_manual_executor_submit_unexecuted() {
+    auto executor = std::make_shared<manual_executor>();
+    executor_shutdowner shutdown(executor);
+
+    auto token = std::make_shared<int>(0);
+
+    auto int_result = executor->submit([token] {
+        return *token;
+    });
+
+    auto void_result = executor->submit([token] {
+        (void)token;
+    });
+
+    assert_equal(token.use_count(), 3);
+
+    // destroying a task that never ran breaks its result and releases the callable
+    assert_equal(executor->clear(), 2);
+    assert_equal(token.use_count(), 1);
+
+    assert_throws<errors::broken_task>([&int_result] {
+        int_result.get();
+    });
+
+    assert_throws<errors::broken_task>([&void_result] {
+        void_result.get();
+    });
+
+    auto shutdown_result = executor->submit([token] {
+        return *token;
+    });
+
+    assert_equal(token.use_count(), 2);
+
+    executor->shutdown();
+    assert_equal(token.use_count(), 1);
+
+    assert_throws<errors::broken_task>([&shutdown_result] {
+        shutdown_result.get();
+    });
+}
+
 void concurrencpp::tests::test_manual_executor_submit() {
     test_manual_executor_submit_exception();
     test_manual_executor_submit_foreign();
     test_manual_executor_submit_inline();
+    test_manual_executor_submit_unexecuted();
 }
 
 void concurrencpp::tests::test_manual_executor_bulk_post_exception() {
@@ -1030,6 +1085,155 @@ void concurrencpp::tests::test_manual_executor_clear() {
     assert_equal(executor->clear(), static_cast<size_t>(0));
 }
 
+void concurrencpp::tests::test_manual_executor_drain() {
+    object_observer observer;
+    const size_t task_count = 1'024;
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner shutdown(executor);
+
+    assert_equal(executor->drain(), static_cast<size_t>(0));
+
+    std::vector<result<size_t>> results;
+    results.resize(task_count);
+
+    for (size_t i = 0; i < task_count; i++) {
+        results[i] = executor->submit(observer.get_testing_stub(i));
+    }
+
+    // tasks enqueued while draining are left for the next drain
+    executor->post([executor, stub = observer.get_testing_stub()]() mutable {
+        executor->post(std::move(stub));
+    });
+
+    assert_equal(executor->drain(), task_count + 1);
+    assert_equal(observer.get_execution_count(), task_count);
+    assert_equal(executor->size(), static_cast<size_t>(1));
+
+    assert_equal(executor->drain(), static_cast<size_t>(1));
+    assert_equal(observer.get_execution_count(), task_count + 1);
+    assert_true(executor->empty());
+
+    assert_executed_locally(observer.get_execution_map());
+
+    for (size_t i = 0; i < task_count; i++) {
+        assert_equal(results[i].get(), i);
+    }
+}
+
+void concurrencpp::tests::test_manual_executor_loop_throwing_task() {
+    object_observer observer;
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner shutdown(executor);
+
+    for (size_t i = 0; i < 3; i++) {
+        executor->post(observer.get_testing_stub());
+    }
+
+    executor->enqueue(concurrencpp::task([] {
+        throw std::runtime_error("");
+    }));
+
+    for (size_t i = 0; i < 3; i++) {
+        executor->post(observer.get_testing_stub());
+    }
+
+    // the tasks after the throwing task stay in the queue
+    assert_throws<std::runtime_error>([executor] {
+        executor->loop(100);
+    });
+
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(3));
+    assert_equal(executor->size(), static_cast<size_t>(3));
+
+    assert_equal(executor->loop(100), static_cast<size_t>(3));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(6));
+
+    // loop takes its tasks as a batch: they are no longer counted by size() and can't be cleared,
+    // tasks that are enqueued while the batch runs are taken by the next batch
+    executor->post([executor, &observer] {
+        assert_equal(executor->size(), static_cast<size_t>(0));
+        assert_equal(executor->clear(), static_cast<size_t>(0));
+        executor->post(observer.get_testing_stub());
+    });
+
+    for (size_t i = 0; i < 2; i++) {
+        executor->post(observer.get_testing_stub());
+    }
+
+    assert_equal(executor->loop(100), static_cast<size_t>(4));
+    assert_true(executor->empty());
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(9));
+
+    // max_count bounds the batch, the rest stay queued
+    for (size_t i = 0; i < 3; i++) {
+        executor->post(observer.get_testing_stub());
+    }
+
+    assert_equal(executor->loop(2), static_cast<size_t>(2));
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_equal(executor->loop(100), static_cast<size_t>(1));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(12));
+
+    // the tasks that were drained after the throwing task go back to the queue, in order
+    executor->enqueue(concurrencpp::task([] {
+        throw std::runtime_error("");
+    }));
+
+    for (size_t i = 0; i < 3; i++) {
+        executor->post(observer.get_testing_stub());
+    }
+
+    assert_throws<std::runtime_error>([executor] {
+        executor->drain();
+    });
+
+    assert_equal(executor->size(), static_cast<size_t>(3));
+    assert_equal(executor->drain(), static_cast<size_t>(3));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(15));
+}
+
+void concurrencpp::tests::test_manual_executor_wakeup_fd() {
+#if defined(CRCPP_UNIX_OS) && defined(__linux__)
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner shutdown(executor);
+
+    const auto fd = executor->wakeup_fd();
+    assert_not_equal(fd, -1);
+    assert_equal(executor->wakeup_fd(), fd);
+
+    auto readable = [fd] {
+        pollfd poll_fd {fd, POLLIN, 0};
+        return ::poll(&poll_fd, 1, 0) == 1;
+    };
+
+    assert_false(readable());
+
+    executor->post([] {});
+    assert_true(readable());
+
+    executor->post([] {});
+    executor->post([] {});
+    assert_true(readable());
+
+    assert_equal(executor->loop(2), static_cast<size_t>(2));
+    assert_true(readable());
+
+    assert_equal(executor->drain(), static_cast<size_t>(1));
+    assert_false(readable());
+
+    executor->post([] {});
+    assert_true(readable());
+
+    assert_equal(executor->clear(), static_cast<size_t>(1));
+    assert_false(readable());
+
+    executor->shutdown();
+    assert_true(readable());
+#else
+    assert_equal(std::make_shared<concurrencpp::manual_executor>()->wakeup_fd(), -1);
+#endif
+}
+
 void concurrencpp::tests::test_manual_executor_wait_for_task() {
     // case 1: tasks already exist
     {
@@ -1550,6 +1754,9 @@ int main() {
     tester.add_step("wait_for_tasks_for", test_manual_executor_wait_for_tasks_for);
     tester.add_step("wait_for_tasks_until", test_manual_executor_wait_for_tasks_until);
     tester.add_step("clear", test_manual_executor_clear);
+    tester.add_step("drain", test_manual_executor_drain);
+    tester.add_step("loop with a throwing task", test_manual_executor_loop_throwing_task);
+    tester.add_step("wakeup_fd", test_manual_executor_wakeup_fd);
 
     tester.launch_test();
     return 0;
@@ -0,0 +1,393 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/object_observer.h"
+#include "utils/executor_shutdowner.h"
+
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace concurrencpp::tests {
+    void test_strand_executor_name();
+    void test_strand_executor_constructor();
+
+    void test_strand_executor_shutdown_method_access();
+    void test_strand_executor_shutdown_more_than_once();
+    void test_strand_executor_shutdown_underlying_executor();
+    void test_strand_executor_shutdown();
+
+    void test_strand_executor_max_concurrency_level();
+
+    void test_strand_executor_scheduling();
+    void test_strand_executor_fifo_order();
+    void test_strand_executor_serial_execution();
+    void test_strand_executor_bulk_submit();
+    void test_strand_executor_concurrent_bulk_post();
+}  // namespace concurrencpp::tests
+
+using concurrencpp::strand_executor;
+using concurrencpp::manual_executor;
+using concurrencpp::thread_pool_executor;
+
+void concurrencpp::tests::test_strand_executor_name() {
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<strand_executor>(underlying_executor);
+    executor_shutdowner shutdown(executor);
+
+    assert_equal(executor->name, concurrencpp::details::consts::k_strand_executor_name);
+}
+
+void concurrencpp::tests::test_strand_executor_constructor() {
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            strand_executor executor({});
+        },
+        concurrencpp::details::consts::k_strand_executor_null_executor_err_msg);
+
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [underlying_executor] {
+            strand_executor executor(underlying_executor, 0);
+        },
+        concurrencpp::details::consts::k_strand_executor_invalid_batch_size_err_msg);
+
+    strand_executor executor(underlying_executor, 16);
+    assert_equal(executor.underlying_executor(), std::static_pointer_cast<concurrencpp::executor>(underlying_executor));
+    assert_equal(executor.max_batch_size(), static_cast<size_t>(16));
+    assert_equal(strand_executor(underlying_executor).max_batch_size(),
+                 concurrencpp::details::consts::k_strand_executor_default_max_batch_size);
+}
+
+void concurrencpp::tests::test_strand_executor_shutdown_method_access() {
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<strand_executor>(underlying_executor);
+    assert_false(executor->shutdown_requested());
+
+    executor->shutdown();
+    assert_true(executor->shutdown_requested());
+    assert_false(underlying_executor->shutdown_requested());
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        executor->enqueue(concurrencpp::task {});
+    });
+
+    assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+        concurrencpp::task array[4];
+        std::span<concurrencpp::task> span = array;
+        executor->enqueue(span);
+    });
+}
+
+void concurrencpp::tests::test_strand_executor_shutdown_more_than_once() {
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<strand_executor>(underlying_executor);
+
+    for (size_t i = 0; i < 4; i++) {
+        executor->shutdown();
+    }
+}
+
+void concurrencpp::tests::test_strand_executor_shutdown_underlying_executor() {
+    // the strand can't be scheduled when it goes from empty to non-empty
+    {
+        object_observer observer;
+        auto underlying_executor = std::make_shared<manual_executor>();
+        auto executor = std::make_shared<strand_executor>(underlying_executor);
+        executor_shutdowner shutdown(executor);
+
+        underlying_executor->shutdown();
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor, &observer] {
+            executor->post(observer.get_testing_stub());
+        });
+
+        assert_true(executor->shutdown_requested());
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor, &observer] {
+            executor->post(observer.get_testing_stub());
+        });
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor, &observer] {
+            std::vector<testing_stub> stubs;
+            stubs.emplace_back(observer.get_testing_stub());
+            executor->bulk_post<testing_stub>(stubs);
+        });
+
+        assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+        assert_equal(observer.get_destruction_count(), static_cast<size_t>(3));
+    }
+
+    // the strand can't be re-scheduled after executing a batch
+    {
+        object_observer observer;
+        auto underlying_executor = std::make_shared<manual_executor>();
+        auto executor = std::make_shared<strand_executor>(underlying_executor, 1);
+        executor_shutdowner shutdown(executor);
+
+        executor->post([underlying_executor] {
+            underlying_executor->shutdown();
+        });
+        executor->post(observer.get_testing_stub());
+
+        // loop_once reports the shutdown that happened during the loop
+        assert_throws<concurrencpp::errors::runtime_shutdown>([underlying_executor] {
+            underlying_executor->loop_once();
+        });
+
+        assert_true(executor->shutdown_requested());
+        assert_equal(observer.get_destruction_count(), static_cast<size_t>(1));
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor, &observer] {
+            executor->post(observer.get_testing_stub());
+        });
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor, &observer] {
+            executor->post(observer.get_testing_stub());
+        });
+
+        assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+    }
+
+    // the underlying executor accepts the strand and destroys it without running it
+    {
+        object_observer observer;
+        auto underlying_executor = std::make_shared<manual_executor>();
+        auto executor = std::make_shared<strand_executor>(underlying_executor);
+        executor_shutdowner shutdown(executor);
+
+        executor->post(observer.get_testing_stub());
+        assert_false(executor->shutdown_requested());
+
+        underlying_executor->shutdown();
+        assert_true(executor->shutdown_requested());
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor, &observer] {
+            executor->post(observer.get_testing_stub());
+        });
+
+        assert_throws<concurrencpp::errors::runtime_shutdown>([executor] {
+            executor->submit([] {
+                return 0;
+            });
+        });
+
+        assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+    }
+}
+
+void concurrencpp::tests::test_strand_executor_shutdown() {
+    test_strand_executor_shutdown_method_access();
+    test_strand_executor_shutdown_more_than_once();
+    test_strand_executor_shutdown_underlying_executor();
+}
+
+void concurrencpp::tests::test_strand_executor_max_concurrency_level() {
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<strand_executor>(underlying_executor);
+    executor_shutdowner shutdown(executor);
+
+    assert_equal(executor->max_concurrency_level(), concurrencpp::details::consts::k_strand_executor_max_concurrency_level);
+}
+
+void concurrencpp::tests::test_strand_executor_scheduling() {
+    object_observer observer;
+    auto underlying_executor = std::make_shared<manual_executor>();
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<strand_executor>(underlying_executor, 4);
+    executor_shutdowner shutdown(executor);
+
+    // the strand is scheduled once, when it goes from empty to non-empty
+    for (size_t i = 0; i < 10; i++) {
+        executor->post(observer.get_testing_stub());
+    }
+
+    assert_equal(underlying_executor->size(), static_cast<size_t>(1));
+    assert_equal(executor->size(), static_cast<size_t>(10));
+
+    // every scheduling executes a bounded batch and re-schedules the strand if tasks remain
+    assert_true(underlying_executor->loop_once());
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(4));
+    assert_equal(underlying_executor->size(), static_cast<size_t>(1));
+    assert_equal(executor->size(), static_cast<size_t>(6));
+
+    assert_true(underlying_executor->loop_once());
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(8));
+
+    assert_true(underlying_executor->loop_once());
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(10));
+    assert_true(underlying_executor->empty());
+
+    executor->post(observer.get_testing_stub());
+    assert_equal(underlying_executor->size(), static_cast<size_t>(1));
+    assert_equal(underlying_executor->loop(100), static_cast<size_t>(1));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(11));
+}
+
+void concurrencpp::tests::test_strand_executor_fifo_order() {
+    constexpr size_t producer_count = 4;
+    constexpr size_t task_count = 2'048;
+
+    auto underlying_executor = std::make_shared<thread_pool_executor>("strand pool", 4, std::chrono::seconds(10));
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<strand_executor>(underlying_executor);
+    executor_shutdowner shutdown(executor);
+
+    std::vector<size_t> last_seen(producer_count, 0);
+    std::atomic_bool in_order = true;
+    std::vector<std::thread> producers;
+
+    for (size_t producer = 0; producer < producer_count; producer++) {
+        producers.emplace_back([&, producer] {
+            for (size_t i = 1; i <= task_count; i++) {
+                executor->post([&, producer, i] {
+                    // not synchronized, the strand guarantees non concurrent execution
+                    if (last_seen[producer] + 1 != i) {
+                        in_order = false;
+                    }
+
+                    last_seen[producer] = i;
+                });
+            }
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    executor->submit([] {}).get();
+
+    assert_true(in_order.load());
+    for (const auto seen : last_seen) {
+        assert_equal(seen, task_count);
+    }
+}
+
+void concurrencpp::tests::test_strand_executor_serial_execution() {
+    constexpr size_t task_count = 1'024;
+
+    auto underlying_executor = std::make_shared<thread_pool_executor>("strand pool", 4, std::chrono::seconds(10));
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<strand_executor>(underlying_executor, 8);
+    executor_shutdowner shutdown(executor);
+
+    std::atomic_size_t in_flight = 0, max_in_flight = 0;
+    std::vector<result<void>> results;
+    results.reserve(task_count);
+
+    for (size_t i = 0; i < task_count; i++) {
+        results.emplace_back(executor->submit([&] {
+            const auto current = in_flight.fetch_add(1) + 1;
+            if (current > max_in_flight.load()) {
+                max_in_flight = current;
+            }
+
+            std::this_thread::yield();
+            in_flight.fetch_sub(1);
+        }));
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_equal(max_in_flight.load(), static_cast<size_t>(1));
+}
+
+void concurrencpp::tests::test_strand_executor_bulk_submit() {
+    object_observer observer;
+    constexpr size_t task_count = 512;
+
+    auto underlying_executor = std::make_shared<thread_pool_executor>("strand pool", 4, std::chrono::seconds(10));
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<strand_executor>(underlying_executor);
+    executor_shutdowner shutdown(executor);
+
+    std::vector<value_testing_stub> stubs;
+    stubs.reserve(task_count);
+
+    for (size_t i = 0; i < task_count; i++) {
+        stubs.emplace_back(observer.get_testing_stub(i));
+    }
+
+    auto results = executor->bulk_submit<value_testing_stub>(stubs);
+
+    for (size_t i = 0; i < task_count; i++) {
+        assert_equal(results[i].get(), i);
+    }
+
+    assert_equal(observer.get_execution_count(), task_count);
+}
+
+void concurrencpp::tests::test_strand_executor_concurrent_bulk_post() {
+    constexpr size_t producer_count = 4;
+    constexpr size_t round_count = 2'000;
+    constexpr size_t tasks_per_round = 3;  // one post + a bulk_post of two
+
+    auto underlying_executor = std::make_shared<thread_pool_executor>("strand pool", 4, std::chrono::seconds(10));
+    executor_shutdowner underlying_shutdown(underlying_executor);
+    auto executor = std::make_shared<strand_executor>(underlying_executor, 1);
+    executor_shutdowner shutdown(executor);
+
+    std::atomic_size_t executed = 0;
+    std::vector<std::thread> producers;
+
+    for (size_t i = 0; i < producer_count; i++) {
+        producers.emplace_back([&] {
+            for (size_t round = 0; round < round_count; round++) {
+                executor->post([&executed] {
+                    executed.fetch_add(1, std::memory_order_relaxed);
+                });
+
+                std::array<task, 2> tasks;
+                for (auto& bulk_task : tasks) {
+                    bulk_task = task([&executed] {
+                        executed.fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+
+                executor->bulk_post<task>(tasks);
+            }
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    // a lost wakeup leaves tasks in the strand forever
+    const auto total = producer_count * round_count * tasks_per_round;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (executed.load(std::memory_order_relaxed) != total && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    assert_equal(executed.load(), total);
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("strand_executor test");
+
+    tester.add_step("name", test_strand_executor_name);
+    tester.add_step("constructor", test_strand_executor_constructor);
+    tester.add_step("shutdown", test_strand_executor_shutdown);
+    tester.add_step("max_concurrency_level", test_strand_executor_max_concurrency_level);
+    tester.add_step("scheduling", test_strand_executor_scheduling);
+    tester.add_step("fifo order", test_strand_executor_fifo_order);
+    tester.add_step("serial execution", test_strand_executor_serial_execution);
+    tester.add_step("bulk_submit", test_strand_executor_bulk_submit);
+    tester.add_step("concurrent bulk_post", test_strand_executor_concurrent_bulk_post);
+
+    tester.launch_test();
+    return 0;
+}
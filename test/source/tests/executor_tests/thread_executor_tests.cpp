@@ -37,6 +37,35 @@ namespace concurrencpp::tests {
     void test_thread_executor_bulk_submit_inline();
     void test_thread_executor_bulk_submit();
 
+    void test_thread_executor_thread_options();
+    void test_thread_executor_thread_cache();
+
+    // posts another task to the executor when a non moved-from instance is destroyed
+    class post_on_destruction {
+
+       private:
+        thread_executor* m_executor;
+        object_observer& m_observer;
+        testing_stub m_stub;
+
+       public:
+        post_on_destruction(thread_executor* executor, object_observer& observer) noexcept :
+            m_executor(executor), m_observer(observer), m_stub(observer.get_testing_stub()) {}
+
+        post_on_destruction(post_on_destruction&& rhs) noexcept :
+            m_executor(std::exchange(rhs.m_executor, nullptr)), m_observer(rhs.m_observer), m_stub(std::move(rhs.m_stub)) {}
+
+        ~post_on_destruction() noexcept {
+            if (m_executor != nullptr) {
+                m_executor->post(m_observer.get_testing_stub());
+            }
+        }
+
+        void operator()() noexcept {
+            m_stub();
+        }
+    };
+
     void assert_unique_execution_threads(const std::unordered_map<size_t, size_t>& execution_map, const size_t expected_thread_count) {
         assert_equal(execution_map.size(), expected_thread_count);
 
@@ -373,6 +402,137 @@ void concurrencpp::tests::test_thread_executor_bulk_submit() {
     test_thread_executor_bulk_post_inline();
 }
 
+void concurrencpp::tests::test_thread_executor_thread_options() {
+    const size_t task_count = 16;
+    std::atomic_size_t start_count = 0, stop_count = 0;
+
+    executor_thread_options thread_options;
+    thread_options.on_thread_start = [&](std::string_view) {
+        start_count.fetch_add(1, std::memory_order_relaxed);
+    };
+    thread_options.on_thread_stop = [&](std::string_view) {
+        stop_count.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    object_observer observer;
+
+    {
+        auto executor = std::make_shared<thread_executor>(thread_options);
+        executor_shutdowner shutdown(executor);
+
+        for (size_t i = 0; i < task_count; i++) {
+            executor->post(observer.get_testing_stub());
+        }
+
+        assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+    }
+
+    // every task runs on its own thread
+    assert_equal(start_count.load(), task_count);
+    assert_equal(stop_count.load(), task_count);
+}
+
+void concurrencpp::tests::test_thread_executor_thread_cache() {
+    const size_t task_count = 8;
+    std::atomic_size_t start_count = 0, stop_count = 0;
+
+    executor_thread_options thread_options;
+    thread_options.on_thread_start = [&](std::string_view) {
+        start_count.fetch_add(1, std::memory_order_relaxed);
+    };
+    thread_options.on_thread_stop = [&](std::string_view) {
+        stop_count.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    // tasks that arrive one after the other reuse the same parked thread
+    {
+        auto executor = std::make_shared<thread_executor>(thread_options, 2, std::chrono::seconds(10));
+        executor_shutdowner shutdown(executor);
+
+        assert_equal(executor->max_cached_threads(), static_cast<size_t>(2));
+        assert_equal(executor->max_cached_thread_idle_time(), std::chrono::milliseconds(std::chrono::seconds(10)));
+
+        for (size_t i = 0; i < task_count; i++) {
+            object_observer observer;
+            executor->post(observer.get_testing_stub());
+            assert_true(observer.wait_execution_count(1, std::chrono::minutes(1)));
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));  // let the thread park
+        }
+
+        assert_equal(start_count.load(), static_cast<size_t>(1));
+    }
+
+    assert_equal(stop_count.load(), static_cast<size_t>(1));
+
+    // every task still gets a thread of its own
+    {
+        auto executor = std::make_shared<thread_executor>(thread_options, 2, std::chrono::seconds(10));
+        executor_shutdowner shutdown(executor);
+
+        std::atomic_size_t running = 0;
+        std::atomic_bool release = false;
+        object_observer observer;
+
+        for (size_t i = 0; i < task_count; i++) {
+            executor->post([&, stub = observer.get_testing_stub()]() mutable {
+                running.fetch_add(1);
+                while (!release) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+
+                stub();
+            });
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+        while (running.load() != task_count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        assert_equal(running.load(), task_count);
+        release = true;
+
+        assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+        assert_unique_execution_threads(observer.get_execution_map(), task_count);
+    }
+
+    // a finished callable is destroyed before its thread parks, so its destructor may enqueue into the executor
+    {
+        auto executor = std::make_shared<thread_executor>(thread_options, 2, std::chrono::seconds(10));
+        executor_shutdowner shutdown(executor);
+
+        object_observer observer;
+        executor->post(post_on_destruction(executor.get(), observer));
+        assert_true(observer.wait_execution_count(1, std::chrono::minutes(1)));
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));  // let the thread park
+
+        executor->post(observer.get_testing_stub());
+        assert_true(observer.wait_execution_count(3, std::chrono::minutes(1)));
+    }
+
+    // parked threads exit after being idle for too long
+    {
+        start_count = 0;
+        stop_count = 0;
+
+        auto executor = std::make_shared<thread_executor>(thread_options, 2, std::chrono::milliseconds(50));
+        executor_shutdowner shutdown(executor);
+
+        object_observer observer;
+        executor->post(observer.get_testing_stub());
+        assert_true(observer.wait_execution_count(1, std::chrono::minutes(1)));
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (stop_count.load() != 1 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        assert_equal(stop_count.load(), static_cast<size_t>(1));
+    }
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -385,6 +545,8 @@ int main() {
     tester.add_step("submit", test_thread_executor_submit);
     tester.add_step("bulk_post", test_thread_executor_bulk_post);
     tester.add_step("bulk_submit", test_thread_executor_bulk_submit);
+    tester.add_step("thread options", test_thread_executor_thread_options);
+    tester.add_step("thread cache", test_thread_executor_thread_cache);
 
     tester.launch_test();
     return 0;
@@ -1,4 +1,5 @@
 #include "concurrencpp/concurrencpp.h"
+#include "concurrencpp/threads/numa_topology.h"
 
 #include "infra/tester.h"
 #include "infra/assertions.h"
@@ -7,6 +8,36 @@
 #include "utils/test_ready_result.h"
 #include "utils/executor_shutdowner.h"
 
+#include <new>
+#include <cstdlib>
+
+namespace concurrencpp::tests {
+    // while armed, allocations fail on every thread that isn't exempt. the test thread and the worker threads exempt
+    // themselves, which leaves the spawner of the pool unable to create threads.
+    std::atomic_bool g_fail_allocations = false;
+    thread_local bool tl_allocations_exempt = false;
+}  // namespace concurrencpp::tests
+
+void* operator new(std::size_t size) {
+    if (concurrencpp::tests::g_fail_allocations.load(std::memory_order_relaxed) && !concurrencpp::tests::tl_allocations_exempt) {
+        throw std::bad_alloc();
+    }
+
+    if (const auto ptr = std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
 namespace concurrencpp::tests {
     void test_thread_pool_executor_name();
 
@@ -37,6 +68,18 @@ namespace concurrencpp::tests {
 
     void test_thread_pool_executor_enqueue_algorithm();
     void test_thread_pool_executor_dynamic_resizing();
+    void test_thread_pool_executor_work_stealing();
+    void test_thread_pool_executor_idle_spinning();
+    void test_thread_pool_executor_idle_worker_lookup();
+    void test_thread_pool_executor_numa_aware();
+    void test_thread_pool_executor_thread_options();
+    void test_thread_pool_executor_failed_spawn();
+    void test_thread_pool_executor_prewarm_and_min_alive_workers();
+    void test_thread_pool_executor_retirement();
+    void test_thread_pool_executor_priorities();
+    void test_thread_pool_executor_next_task_slot();
+    void test_thread_pool_executor_load_aware_bulk_enqueue();
+    void test_thread_pool_executor_blocking_region();
 }  // namespace concurrencpp::tests
 
 using concurrencpp::details::thread;
@@ -547,6 +590,684 @@ void concurrencpp::tests::test_thread_pool_executor_dynamic_resizing() {
     }
 }
 
+void concurrencpp::tests::test_thread_pool_executor_work_stealing() {
+    // tasks that were enqueued locally by a busy worker are stolen by idle workers
+    const size_t worker_count = 4;
+    const size_t task_count = 256;
+    object_observer observer;
+
+    thread_pool_executor_options options;
+    options.work_stealing = true;
+
+    auto executor = std::make_shared<thread_pool_executor>("threadpool", worker_count, std::chrono::seconds(10), options);
+    executor_shutdowner shutdown(executor);
+
+    assert_true(executor->options().work_stealing);
+
+    executor->post([executor, &observer] {
+        auto make_task = [&observer] {
+            return [stub = observer.get_testing_stub()]() mutable {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                stub();
+            };
+        };
+
+        std::vector<decltype(make_task())> tasks;
+        tasks.reserve(task_count);
+
+        for (size_t i = 0; i < task_count; i++) {
+            tasks.emplace_back(make_task());
+        }
+
+        executor->bulk_post<decltype(make_task())>(tasks);  // enqueued to the private queue of this worker
+    });
+
+    assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+    assert_true(observer.wait_destruction_count(task_count, std::chrono::minutes(1)));
+
+    assert_true(observer.get_execution_map().size() > 1);
+}
+
+void concurrencpp::tests::test_thread_pool_executor_idle_spinning() {
+    // tasks that arrive while workers spin or yield are picked up without parking
+    const size_t worker_count = 2;
+    const size_t task_count = 512;
+    object_observer observer;
+
+    thread_pool_executor_options options;
+    options.idle_spin_time = std::chrono::microseconds(200);
+    options.idle_yield_time = std::chrono::microseconds(300);
+    options.adaptive_idle_spinning = true;
+
+    auto executor = std::make_shared<thread_pool_executor>("threadpool", worker_count, std::chrono::seconds(10), options);
+    executor_shutdowner shutdown(executor);
+
+    assert_equal(executor->options().idle_spin_time, options.idle_spin_time);
+    assert_equal(executor->options().idle_yield_time, options.idle_yield_time);
+    assert_true(executor->options().adaptive_idle_spinning);
+
+    for (size_t i = 0; i < task_count; i++) {
+        executor->post(observer.get_testing_stub());
+
+        if (i % 16 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+
+        if (i % 128 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));  // long enough to park
+        }
+    }
+
+    assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+    assert_true(observer.wait_destruction_count(task_count, std::chrono::minutes(1)));
+}
+
+void concurrencpp::tests::test_thread_pool_executor_idle_worker_lookup() {
+    // idle workers are found across several bitmap words, every task lands on a different idle worker
+    const size_t worker_count = 64 * 2 + 3;
+    object_observer observer;
+    auto wc = std::make_shared<concurrencpp::details::wait_context>();
+    auto executor = std::make_shared<thread_pool_executor>("threadpool", worker_count, std::chrono::seconds(10));
+    executor_shutdowner shutdown(executor);
+
+    for (size_t i = 0; i < worker_count; i++) {
+        executor->post([wc, stub = observer.get_testing_stub()]() mutable {
+            wc->wait();
+            stub();
+        });
+    }
+
+    wc->notify();
+
+    assert_true(observer.wait_execution_count(worker_count, std::chrono::minutes(1)));
+    assert_equal(observer.get_execution_map().size(), worker_count);
+
+    for (const auto& [thread_id, invocation_count] : observer.get_execution_map()) {
+        assert_equal(invocation_count, static_cast<size_t>(1));
+    }
+}
+
+void concurrencpp::tests::test_thread_pool_executor_numa_aware() {
+    // unknown nodes are rejected
+    {
+        thread_pool_executor_options options;
+        options.numa_aware = true;
+        options.numa_nodes = {static_cast<size_t>(-1)};
+
+        assert_throws_with_error_message<std::invalid_argument>(
+            [&options] {
+                thread_pool_executor("threadpool", 4, std::chrono::seconds(10), options);
+            },
+            concurrencpp::details::consts::k_thread_pool_executor_unknown_numa_node_err_msg);
+    }
+
+    // tasks are executed both with donation and with stealing
+    for (const auto work_stealing : {false, true}) {
+        const size_t worker_count = 4;
+        const size_t task_count = 256;
+        object_observer observer;
+
+        thread_pool_executor_options options;
+        options.numa_aware = true;
+        options.numa_nodes = {concurrencpp::details::numa_topology::system().nodes()[0].id};
+        options.work_stealing = work_stealing;
+
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", worker_count, std::chrono::seconds(10), options);
+        executor_shutdowner shutdown(executor);
+
+        assert_true(executor->options().numa_aware);
+
+        executor->post([executor, &observer] {
+            for (size_t i = 0; i < task_count; i++) {
+                executor->post(observer.get_testing_stub());
+            }
+        });
+
+        for (size_t i = 0; i < task_count; i++) {
+            executor->post(observer.get_testing_stub());
+        }
+
+        assert_true(observer.wait_execution_count(task_count * 2, std::chrono::minutes(1)));
+        assert_true(observer.wait_destruction_count(task_count * 2, std::chrono::minutes(1)));
+    }
+}
+
+void concurrencpp::tests::test_thread_pool_executor_thread_options() {
+    const size_t worker_count = 4;
+    const size_t task_count = 1'024;
+    std::atomic_size_t start_count = 0, stop_count = 0;
+    object_observer observer;
+
+    thread_pool_executor_options options;
+    options.thread_options.cpu_affinity = {0};
+    options.thread_options.on_thread_start = [&](std::string_view) {
+        start_count.fetch_add(1, std::memory_order_relaxed);
+    };
+    options.thread_options.on_thread_stop = [&](std::string_view) {
+        stop_count.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    {
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", worker_count, std::chrono::seconds(10), options);
+        executor_shutdowner shutdown(executor);
+
+        for (size_t i = 0; i < task_count; i++) {
+            executor->post([stub = observer.get_testing_stub()]() mutable {
+                const auto cpu = concurrencpp::details::thread::current_cpu();
+                if (cpu != static_cast<size_t>(-1)) {
+                    assert_equal(cpu, static_cast<size_t>(0));
+                }
+
+                stub();
+            });
+        }
+
+        assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+    }
+
+    assert_true(start_count.load() >= 1);
+    assert_true(start_count.load() <= worker_count);
+    assert_equal(start_count.load(), stop_count.load());
+}
+
+void concurrencpp::tests::test_thread_pool_executor_failed_spawn() {
+    object_observer observer;
+
+    thread_pool_executor_options options;
+    options.thread_options.on_thread_start = [](std::string_view) {
+        tl_allocations_exempt = true;
+    };
+
+    tl_allocations_exempt = true;
+
+    auto executor = std::make_shared<thread_pool_executor>("threadpool", 1, std::chrono::seconds(10), options);
+    executor_shutdowner shutdown(executor);
+
+    // the worker thread can't be created, the task stays queued
+    g_fail_allocations = true;
+    executor->post(observer.get_testing_stub());
+    executor->post(observer.get_testing_stub());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert_equal(observer.get_execution_count(), static_cast<size_t>(0));
+    assert_equal(executor->spawned_thread_count(), static_cast<size_t>(0));
+
+    // nobody enqueues anymore, the spawner retries on its own
+    g_fail_allocations = false;
+    assert_true(observer.wait_execution_count(2, std::chrono::minutes(1)));
+    assert_equal(executor->spawned_thread_count(), static_cast<size_t>(1));
+}
+
+void concurrencpp::tests::test_thread_pool_executor_prewarm_and_min_alive_workers() {
+    const size_t worker_count = 4;
+    const size_t min_alive_workers = 2;
+    const size_t task_count = 64;
+    std::atomic_size_t start_count = 0, stop_count = 0;
+    object_observer observer;
+
+    thread_pool_executor_options options;
+    options.prewarm_workers = true;
+    options.min_alive_workers = min_alive_workers;
+    options.thread_options.on_thread_start = [&](std::string_view) {
+        start_count.fetch_add(1, std::memory_order_relaxed);
+    };
+    options.thread_options.on_thread_stop = [&](std::string_view) {
+        stop_count.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    {
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", worker_count, std::chrono::milliseconds(50), options);
+        executor_shutdowner shutdown(executor);
+
+        // all workers are started without anything being posted
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (start_count.load() != worker_count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        assert_equal(start_count.load(), worker_count);
+
+        // only the surplus workers retire after being idle
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        assert_equal(stop_count.load(), worker_count - min_alive_workers);
+
+        // retired workers are brought back when needed
+        for (size_t i = 0; i < task_count; i++) {
+            executor->post([stub = observer.get_testing_stub()]() mutable {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                stub();
+            });
+        }
+
+        assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+        assert_true(start_count.load() >= worker_count);
+    }
+
+    assert_equal(start_count.load(), stop_count.load());
+}
+
+void concurrencpp::tests::test_thread_pool_executor_retirement() {
+    const size_t worker_count = 4;
+
+    const auto wait_for_retirements = [](thread_pool_executor& executor, size_t count) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (executor.retired_thread_count() < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        return executor.retired_thread_count() == count;
+    };
+
+    // surplus workers retire only after several idle periods, core workers never do
+    {
+        thread_pool_executor_options options;
+        options.prewarm_workers = true;
+        options.min_alive_workers = 1;
+        options.retirement_idle_periods = 10;
+
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", worker_count, std::chrono::milliseconds(50), options);
+        executor_shutdowner shutdown(executor);
+
+        assert_equal(executor->spawned_thread_count(), worker_count);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        assert_equal(executor->retired_thread_count(), static_cast<size_t>(0));
+
+        assert_true(wait_for_retirements(*executor, worker_count - 1));
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        assert_equal(executor->retired_thread_count(), worker_count - 1);
+    }
+
+    // staggered retirement retires one surplus worker per idle period
+    {
+        thread_pool_executor_options options;
+        options.prewarm_workers = true;
+        options.staggered_retirement = true;
+
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", worker_count, std::chrono::milliseconds(300), options);
+        executor_shutdowner shutdown(executor);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(450));
+        assert_equal(executor->retired_thread_count(), static_cast<size_t>(1));
+
+        assert_true(wait_for_retirements(*executor, worker_count));
+
+        object_observer observer;
+        executor->post(observer.get_testing_stub());
+        assert_true(observer.wait_execution_count(1, std::chrono::minutes(1)));
+        assert_equal(executor->spawned_thread_count(), worker_count + 1);
+    }
+}
+
+void concurrencpp::tests::test_thread_pool_executor_priorities() {
+    // runs <<enqueue>> while the only worker is blocked, returns the order the enqueued tasks were executed at
+    const auto record_execution_order = [](const thread_pool_executor_options& options, auto enqueue) {
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", 1, std::chrono::seconds(10), options);
+        executor_shutdowner shutdown(executor);
+
+        std::atomic_bool started = false, released = false;
+        executor->post([&] {
+            started = true;
+            while (!released) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+        while (!started) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::vector<char> order;
+        std::atomic_size_t execution_count = 0;
+        const auto task_count = enqueue(*executor, [&order, &execution_count](char tag) {
+            order.emplace_back(tag);
+            execution_count.fetch_add(1, std::memory_order_release);
+        });
+
+        released = true;
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+        while (execution_count.load(std::memory_order_acquire) != task_count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        assert_equal(execution_count.load(std::memory_order_acquire), task_count);
+        return std::string(order.begin(), order.end());
+    };
+
+    // higher priorities first, FIFO within a priority
+    {
+        thread_pool_executor_options options;
+        const auto order = record_execution_order(options, [](thread_pool_executor& executor, auto record) {
+            for (size_t i = 0; i < 3; i++) {
+                executor.post(task_priority::low, record, 'L');
+                executor.post(record, 'N');
+                executor.post(task_priority::high, record, 'H');
+            }
+
+            return static_cast<size_t>(9);
+        });
+
+        assert_equal(order, std::string("HHHNNNLLL"));
+    }
+
+    // a starving lane is served once every <<priority_starvation_limit>> tasks
+    {
+        thread_pool_executor_options options;
+        options.priority_starvation_limit = 2;
+
+        const auto order = record_execution_order(options, [](thread_pool_executor& executor, auto record) {
+            for (size_t i = 0; i < 3; i++) {
+                executor.post(task_priority::low, record, 'L');
+            }
+
+            for (size_t i = 0; i < 6; i++) {
+                executor.post(task_priority::high, record, 'H');
+            }
+
+            return static_cast<size_t>(9);
+        });
+
+        assert_equal(order, std::string("HHLHHLHHL"));
+    }
+
+    // submit, bulk_post and bulk_submit
+    {
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", 2, std::chrono::seconds(10));
+        executor_shutdowner shutdown(executor);
+
+        auto result = executor->submit(
+            task_priority::high,
+            [](int a, int b) {
+                return a + b;
+            },
+            1,
+            2);
+        assert_equal(result.get(), 3);
+
+        object_observer observer;
+        std::vector<testing_stub> stubs;
+        for (size_t i = 0; i < 16; i++) {
+            stubs.emplace_back(observer.get_testing_stub());
+        }
+
+        executor->bulk_post<testing_stub>(task_priority::low, stubs);
+        assert_true(observer.wait_execution_count(16, std::chrono::minutes(1)));
+
+        std::vector<value_testing_stub> value_stubs;
+        for (size_t i = 0; i < 16; i++) {
+            value_stubs.emplace_back(observer.get_testing_stub(i));
+        }
+
+        auto results = executor->bulk_submit<value_testing_stub>(task_priority::high, value_stubs);
+        for (size_t i = 0; i < results.size(); i++) {
+            assert_equal(results[i].get(), i);
+        }
+
+        assert_throws_with_error_message<std::invalid_argument>(
+            [executor] {
+                executor->post(static_cast<task_priority>(42), [] {
+                });
+            },
+            concurrencpp::details::consts::k_thread_pool_executor_invalid_priority_err_msg);
+    }
+}
+
+void concurrencpp::tests::test_thread_pool_executor_next_task_slot() {
+    thread_pool_executor_options options;
+    options.next_task_slot = true;
+
+    // a continuation stays on the worker that scheduled it even if other workers are idle
+    {
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", 4, std::chrono::seconds(10), options);
+        executor_shutdowner shutdown(executor);
+
+        auto result = executor->submit([executor] {
+            executor->post([] {
+            });  // we don't look empty anymore
+
+            auto continuation = executor->submit([] {
+                return std::this_thread::get_id();
+            });
+
+            return std::make_pair(std::this_thread::get_id(), std::move(continuation));
+        });
+
+        auto [this_thread, continuation] = result.get();
+        assert_true(continuation.get() == this_thread);
+    }
+
+    // chains of continuations give way to queued tasks every <<next_task_slot_limit>> tasks
+    {
+        options.next_task_slot_limit = 2;
+
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", 1, std::chrono::seconds(10), options);
+        executor_shutdowner shutdown(executor);
+
+        std::string order;
+        std::atomic_size_t execution_count = 0;
+        const size_t chain_length = 6, queued_count = 3;
+
+        std::function<void(size_t)> chain = [&](size_t remaining) {
+            order += 'S';
+            execution_count.fetch_add(1, std::memory_order_release);
+            if (remaining != 0) {
+                executor->post([&chain, remaining] {
+                    chain(remaining - 1);
+                });
+            }
+        };
+
+        executor->post([&] {
+            for (size_t i = 0; i < queued_count; i++) {
+                executor->post(task_priority::low, [&] {
+                    order += 'L';
+                    execution_count.fetch_add(1, std::memory_order_release);
+                });
+            }
+
+            executor->post([&chain] {
+                chain(chain_length - 1);
+            });
+        });
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+        while (execution_count.load(std::memory_order_acquire) != chain_length + queued_count &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        assert_equal(execution_count.load(std::memory_order_acquire), chain_length + queued_count);
+        assert_equal(order, std::string("SSLSSLSSL"));
+    }
+}
+
+void concurrencpp::tests::test_thread_pool_executor_load_aware_bulk_enqueue() {
+    const size_t task_count = 64;
+    auto executor = std::make_shared<thread_pool_executor>("threadpool", 2, std::chrono::seconds(10));
+    executor_shutdowner shutdown(executor);
+
+    // one worker is blocked with a backlog, the other one is idle
+    std::atomic_bool blocked = false, released = false;
+    object_observer backlog_observer;
+
+    executor->post([&] {
+        std::vector<testing_stub> backlog;
+        for (size_t i = 0; i < task_count; i++) {
+            backlog.emplace_back(backlog_observer.get_testing_stub());
+        }
+
+        executor->bulk_post<testing_stub>(backlog);
+
+        blocked = true;
+        while (!released) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    while (!blocked) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // all the new tasks go to the idle worker
+    object_observer observer;
+    std::vector<testing_stub> stubs;
+    for (size_t i = 0; i < task_count; i++) {
+        stubs.emplace_back(observer.get_testing_stub());
+    }
+
+    executor->bulk_post<testing_stub>(stubs);
+
+    assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+    assert_equal(backlog_observer.get_execution_count(), static_cast<size_t>(0));
+
+    released = true;
+    assert_true(backlog_observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+}
+
+void concurrencpp::tests::test_thread_pool_executor_blocking_region() {
+    // outside of a worker thread, nothing happens
+    {
+        blocking_region region;
+        assert_false(region.compensated());
+    }
+
+    // without compensation workers, blocked workers are only counted
+    {
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", 1, std::chrono::seconds(10));
+        executor_shutdowner shutdown(executor);
+
+        auto result = executor->submit([executor] {
+            blocking_region region;
+            return std::make_pair(region.compensated(), executor->blocked_worker_count());
+        });
+
+        const auto [compensated, blocked_count] = result.get();
+        assert_false(compensated);
+        assert_equal(blocked_count, static_cast<size_t>(1));
+        assert_equal(executor->blocked_worker_count(), static_cast<size_t>(0));
+    }
+
+    thread_pool_executor_options options;
+    options.max_compensation_workers = 1;
+
+    // a task queued behind the blocked worker is handed over to the compensation worker
+    {
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", 1, std::chrono::seconds(10), options);
+        executor_shutdowner shutdown(executor);
+        assert_equal(executor->max_concurrency_level(), 1);
+
+        auto result = executor->submit([executor] {
+            auto continuation = executor->submit([] {
+                return std::this_thread::get_id();
+            });
+
+            blocking_region region;
+            assert_true(region.compensated());
+            assert_equal(executor->compensating_worker_count(), static_cast<size_t>(1));
+            assert_not_equal(continuation.get(), std::this_thread::get_id());
+
+            // nested regions don't take another slot
+            blocking_region nested_region;
+            assert_false(nested_region.compensated());
+            assert_equal(executor->blocked_worker_count(), static_cast<size_t>(1));
+        });
+
+        result.get();
+        assert_equal(executor->blocked_worker_count(), static_cast<size_t>(0));
+        assert_equal(executor->compensating_worker_count(), static_cast<size_t>(0));
+    }
+
+    // new tasks run while the only worker is blocked
+    {
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", 1, std::chrono::seconds(10), options);
+        executor_shutdowner shutdown(executor);
+
+        std::atomic_bool blocked = false, released = false;
+        auto blocked_task = executor->submit([&] {
+            blocking_region region;
+            blocked = true;
+            while (!released) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+        while (!blocked) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        object_observer observer;
+        const size_t task_count = 16;
+        for (size_t i = 0; i < task_count; i++) {
+            executor->post(observer.get_testing_stub());
+        }
+
+        assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+
+        released = true;
+        blocked_task.get();
+    }
+
+    // compensation workers are capped
+    {
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", 2, std::chrono::seconds(10), options);
+        executor_shutdowner shutdown(executor);
+
+        std::atomic_size_t blocked_count = 0, compensated_count = 0;
+        std::atomic_bool released = false;
+        std::vector<result<void>> results;
+
+        for (size_t i = 0; i < 2; i++) {
+            results.emplace_back(executor->submit([&] {
+                blocking_region region;
+                compensated_count += region.compensated() ? 1 : 0;
+                ++blocked_count;
+                while (!released) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }));
+        }
+
+        while (blocked_count != 2) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        assert_equal(compensated_count.load(), static_cast<size_t>(1));
+        assert_equal(executor->compensating_worker_count(), static_cast<size_t>(1));
+
+        released = true;
+        for (auto& result : results) {
+            result.get();
+        }
+    }
+
+    // a blocked worker enqueues a batch like an external thread does
+    {
+        options.max_compensation_workers = 2;
+        auto executor = std::make_shared<thread_pool_executor>("threadpool", 2, std::chrono::seconds(10), options);
+        executor_shutdowner shutdown(executor);
+
+        object_observer observer;
+        const size_t task_count = 16;
+
+        auto result = executor->submit([&] {
+            blocking_region region;
+
+            std::vector<value_testing_stub> stubs;
+            for (size_t i = 0; i < task_count; i++) {
+                stubs.emplace_back(observer.get_testing_stub(i));
+            }
+
+            executor->bulk_post<value_testing_stub>(stubs);
+            assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+        });
+
+        result.get();
+        assert_equal(observer.get_execution_count(), task_count);
+    }
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -560,6 +1281,18 @@ int main() {
     tester.add_step("bulk_submit", test_thread_pool_executor_bulk_submit);
     tester.add_step("enqueuing algorithm", test_thread_pool_executor_enqueue_algorithm);
     tester.add_step("dynamic resizing", test_thread_pool_executor_dynamic_resizing);
+    tester.add_step("work stealing", test_thread_pool_executor_work_stealing);
+    tester.add_step("idle spinning", test_thread_pool_executor_idle_spinning);
+    tester.add_step("idle worker lookup", test_thread_pool_executor_idle_worker_lookup);
+    tester.add_step("numa aware", test_thread_pool_executor_numa_aware);
+    tester.add_step("thread options", test_thread_pool_executor_thread_options);
+    tester.add_step("prewarm and min alive workers", test_thread_pool_executor_prewarm_and_min_alive_workers);
+    tester.add_step("retirement", test_thread_pool_executor_retirement);
+    tester.add_step("priorities", test_thread_pool_executor_priorities);
+    tester.add_step("next task slot", test_thread_pool_executor_next_task_slot);
+    tester.add_step("load aware bulk enqueue", test_thread_pool_executor_load_aware_bulk_enqueue);
+    tester.add_step("blocking region", test_thread_pool_executor_blocking_region);
+    tester.add_step("failed spawn", test_thread_pool_executor_failed_spawn);
 
     tester.launch_test();
     return 0;
@@ -37,6 +37,9 @@ namespace concurrencpp::tests {
     void test_worker_thread_executor_bulk_submit_inline();
     void test_worker_thread_executor_bulk_submit();
 
+    void test_worker_thread_executor_thread_options();
+    void test_worker_thread_executor_busy_poll();
+
     void assert_unique_execution_thread(const std::unordered_map<size_t, size_t>& execution_map) {
         assert_equal(execution_map.size(), 1);
         assert_not_equal(execution_map.begin()->first, concurrencpp::details::thread::get_current_virtual_id());
@@ -363,6 +366,76 @@ void concurrencpp::tests::test_worker_thread_executor_bulk_submit() {
     test_worker_thread_executor_bulk_submit_inline();
 }
 
+void concurrencpp::tests::test_worker_thread_executor_thread_options() {
+    std::atomic_size_t start_count = 0, stop_count = 0;
+    std::string started_thread_name;
+
+    executor_thread_options thread_options;
+    thread_options.cpu_affinity = {0};
+    thread_options.on_thread_start = [&](std::string_view thread_name) {
+        started_thread_name = thread_name;
+        start_count.fetch_add(1, std::memory_order_relaxed);
+    };
+    thread_options.on_thread_stop = [&](std::string_view) {
+        stop_count.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    {
+        auto executor = std::make_shared<worker_thread_executor>(thread_options);
+        executor_shutdowner shutdown(executor);
+
+        const auto cpu = executor
+                             ->submit([] {
+                                 return concurrencpp::details::thread::current_cpu();
+                             })
+                             .get();
+
+        if (cpu != static_cast<size_t>(-1)) {
+            assert_equal(cpu, static_cast<size_t>(0));
+        }
+
+        assert_equal(start_count.load(), static_cast<size_t>(1));
+        assert_equal(started_thread_name, concurrencpp::details::make_executor_worker_name(executor->name));
+    }
+
+    assert_equal(start_count.load(), static_cast<size_t>(1));
+    assert_equal(stop_count.load(), static_cast<size_t>(1));
+}
+
+
+void concurrencpp::tests::test_worker_thread_executor_busy_poll() {
+    executor_thread_options thread_options;
+    thread_options.cpu_affinity = {0};
+
+    auto executor = std::make_shared<worker_thread_executor>(thread_options, true);
+    executor_shutdowner shutdown(executor);
+
+    assert_true(executor->busy_polling());
+
+    {
+        auto default_executor = std::make_shared<worker_thread_executor>();
+        executor_shutdowner default_shutdown(default_executor);
+        assert_false(default_executor->busy_polling());
+    }
+
+    for (size_t i = 0; i < 100; i++) {
+        assert_equal(executor->submit([i] {
+                                  return i;
+                              })
+                         .get(),
+                     i);
+    }
+
+    constexpr size_t task_count = 1'024;
+    object_observer observer;
+    for (size_t i = 0; i < task_count; i++) {
+        executor->post(observer.get_testing_stub());
+    }
+
+    assert_true(observer.wait_execution_count(task_count, std::chrono::minutes(1)));
+    assert_equal(observer.get_execution_map().size(), static_cast<size_t>(1));
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -375,6 +448,8 @@ int main() {
     tester.add_step("submit", test_worker_thread_executor_submit);
     tester.add_step("bulk_post", test_worker_thread_executor_bulk_post);
     tester.add_step("bulk_submit", test_worker_thread_executor_bulk_submit);
+    tester.add_step("thread options", test_worker_thread_executor_thread_options);
+    tester.add_step("busy poll", test_worker_thread_executor_busy_poll);
 
     tester.launch_test();
     return 0;
@@ -8,6 +8,9 @@
 #include "utils/test_ready_result.h"
 #include "utils/test_ready_lazy_result.h"
 
+#include <thread>
+#include <vector>
+
 namespace concurrencpp::tests {
     template<class type>
     void test_lazy_result_constructor_impl();
@@ -52,6 +55,8 @@ namespace concurrencpp::tests {
     void test_lazy_result_assignment_operator_impl();
 
     void test_lazy_result_assignment_operator();
+
+    void test_lazy_result_frame_allocation();
 }  // namespace concurrencpp::tests
 
 namespace concurrencpp::tests {
@@ -489,6 +494,84 @@ void concurrencpp::tests::test_lazy_result_assignment_operator() {
     test_lazy_result_assignment_operator_impl<std::string&>();
 }
 
+namespace concurrencpp::tests {
+    lazy_result<size_t> lazy_sum(size_t depth) {
+        if (depth == 0) {
+            co_return 0;
+        }
+
+        co_return depth + co_await lazy_sum(depth - 1);
+    }
+
+    lazy_result<size_t> lazy_divide_and_conquer(size_t begin, size_t end) {
+        if (end - begin == 1) {
+            co_return begin;
+        }
+
+        const auto middle = begin + (end - begin) / 2;
+        auto left = lazy_divide_and_conquer(begin, middle);
+        auto right = lazy_divide_and_conquer(middle, end);
+
+        co_return co_await left + co_await right;
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_lazy_result_frame_allocation() {
+    // frames created and destroyed in LIFO order
+    assert_equal(lazy_sum(1'000).run().get(), static_cast<size_t>(1'000 * 1'001 / 2));
+    assert_equal(lazy_divide_and_conquer(0, 4'096).run().get(), static_cast<size_t>(4'096 * 4'095 / 2));
+
+    // frames destroyed out of order
+    {
+        std::vector<lazy_result<size_t>> lazies;
+        for (size_t i = 0; i < 64; i++) {
+            lazies.emplace_back(lazy_sum(i));
+        }
+
+        for (size_t i = 0; i < lazies.size(); i += 2) {
+            lazies[i] = {};
+        }
+
+        assert_equal(lazy_sum(10).run().get(), static_cast<size_t>(55));
+
+        for (size_t i = 1; i < lazies.size(); i += 2) {
+            assert_equal(lazies[i].run().get(), i * (i + 1) / 2);
+        }
+    }
+
+    // frames destroyed by another thread
+    {
+        std::vector<lazy_result<size_t>> lazies;
+        for (size_t i = 0; i < 64; i++) {
+            lazies.emplace_back(lazy_divide_and_conquer(0, 64));
+        }
+
+        std::thread destroying_thread([&lazies] {
+            for (auto& lazy : lazies) {
+                assert_equal(lazy.run().get(), static_cast<size_t>(64 * 63 / 2));
+            }
+
+            lazies.clear();
+        });
+
+        destroying_thread.join();
+
+        assert_equal(lazy_divide_and_conquer(0, 64).run().get(), static_cast<size_t>(64 * 63 / 2));
+    }
+
+    // frames that outlive the thread that created them
+    {
+        lazy_result<size_t> lazy;
+        std::thread creating_thread([&lazy] {
+            lazy = lazy_sum(100);
+        });
+
+        creating_thread.join();
+
+        assert_equal(lazy.run().get(), static_cast<size_t>(5'050));
+    }
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -501,6 +584,7 @@ int main() {
     tester.add_step("operator co_await", test_lazy_result_co_await_operator);
     tester.add_step("run", test_lazy_result_run);
     tester.add_step("operator =", test_lazy_result_assignment_operator);
+    tester.add_step("frame allocation", test_lazy_result_frame_allocation);
 
     tester.launch_test();
     return 0;
@@ -1,4 +1,5 @@
 #include "concurrencpp/concurrencpp.h"
+#include "concurrencpp/threads/numa_topology.h"
 
 #include "infra/tester.h"
 #include "infra/assertions.h"
@@ -7,6 +8,8 @@ namespace concurrencpp::tests {
     void test_runtime_constructor();
     void test_runtime_destructor();
     void test_runtime_version();
+    void test_runtime_numa_node_pools();
+    void test_runtime_thread_options();
 }  // namespace concurrencpp::tests
 
 namespace concurrencpp::tests {
@@ -37,8 +40,16 @@ void concurrencpp::tests::test_runtime_constructor() {
     opts.max_cpu_threads = 3;
     opts.max_thread_pool_executor_waiting_time = std::chrono::milliseconds(12345);
 
+    opts.cpu_pool_options.work_stealing = true;
+    opts.cpu_pool_options.idle_spin_time = std::chrono::microseconds(25);
+    opts.cpu_pool_options.adaptive_idle_spinning = true;
+
     opts.max_background_threads = 7;
     opts.max_background_executor_waiting_time = std::chrono::milliseconds(54321);
+    opts.background_pool_options.work_stealing = false;
+
+    opts.max_thread_executor_cached_threads = 5;
+    opts.max_thread_executor_waiting_time = std::chrono::milliseconds(4321);
 
     concurrencpp::runtime runtime(opts);
     auto dummy_ex = runtime.make_executor<dummy_executor>("dummy_executor", 1, 4.4f);
@@ -58,6 +69,17 @@ void concurrencpp::tests::test_runtime_constructor() {
     assert_equal(runtime.thread_pool_executor()->max_worker_idle_time(), opts.max_thread_pool_executor_waiting_time);
     assert_equal(runtime.background_executor()->max_concurrency_level(), opts.max_background_threads);
     assert_equal(runtime.background_executor()->max_worker_idle_time(), opts.max_background_executor_waiting_time);
+
+    assert_true(runtime.thread_pool_executor()->options().work_stealing);
+    assert_false(runtime.background_executor()->options().work_stealing);
+    assert_equal(runtime.thread_pool_executor()->options().idle_spin_time, opts.cpu_pool_options.idle_spin_time);
+    assert_true(runtime.thread_pool_executor()->options().adaptive_idle_spinning);
+    assert_equal(runtime.background_executor()->options().idle_spin_time, opts.background_pool_options.idle_spin_time);
+
+    assert_equal(runtime.thread_executor()->max_cached_threads(), opts.max_thread_executor_cached_threads);
+    assert_equal(runtime.thread_executor()->max_cached_thread_idle_time(), opts.max_thread_executor_waiting_time);
+
+    assert_true(runtime.numa_node_executors().empty());
 }
 
 void concurrencpp::tests::test_runtime_destructor() {
@@ -86,6 +108,75 @@ void concurrencpp::tests::test_runtime_version() {
     assert_equal(std::get<2>(version), concurrencpp::details::consts::k_concurrencpp_version_revision);
 }
 
+void concurrencpp::tests::test_runtime_numa_node_pools() {
+    std::vector<std::shared_ptr<concurrencpp::thread_pool_executor>> executors;
+
+    {
+        concurrencpp::runtime_options opts;
+        opts.numa_node_pools = true;
+        opts.cpu_pool_options.work_stealing = true;
+
+        concurrencpp::runtime runtime(opts);
+        executors = runtime.numa_node_executors();
+
+        const auto& nodes = concurrencpp::details::numa_topology::system().nodes();
+        assert_equal(executors.size(), nodes.size());
+
+        for (size_t i = 0; i < executors.size(); i++) {
+            const auto& options = executors[i]->options();
+            assert_true(options.numa_aware);
+            assert_true(options.work_stealing);
+            assert_equal(options.numa_nodes.size(), static_cast<size_t>(1));
+            assert_equal(options.numa_nodes[0], nodes[i].id);
+            assert_equal(static_cast<size_t>(executors[i]->max_concurrency_level()), nodes[i].cpus.size());
+
+            auto result = executors[i]->submit([] {
+                return 123;
+            });
+
+            assert_equal(result.get(), 123);
+        }
+    }
+
+    for (auto& executor : executors) {
+        assert_true(executor->shutdown_requested());
+    }
+}
+
+void concurrencpp::tests::test_runtime_thread_options() {
+    std::atomic_size_t thread_executor_starts = 0, worker_thread_starts = 0, worker_thread_stops = 0;
+
+    {
+        concurrencpp::runtime_options opts;
+        opts.thread_executor_options.on_thread_start = [&](std::string_view) {
+            thread_executor_starts.fetch_add(1, std::memory_order_relaxed);
+        };
+        opts.worker_thread_executor_options.on_thread_start = [&](std::string_view) {
+            worker_thread_starts.fetch_add(1, std::memory_order_relaxed);
+        };
+        opts.worker_thread_executor_options.on_thread_stop = [&](std::string_view) {
+            worker_thread_stops.fetch_add(1, std::memory_order_relaxed);
+        };
+
+        concurrencpp::runtime runtime(opts);
+        runtime.thread_executor()->submit([] {}).get();
+        runtime.make_worker_thread_executor()->submit([] {}).get();
+        runtime.make_worker_thread_executor()->submit([] {}).get();
+
+        auto busy_poll_executor = runtime.make_worker_thread_executor(true, {0});
+        assert_true(busy_poll_executor->busy_polling());
+        assert_equal(busy_poll_executor->submit([] {
+                                          return 1;
+                                      })
+                         .get(),
+                     1);
+    }
+
+    assert_equal(thread_executor_starts.load(), static_cast<size_t>(1));
+    assert_equal(worker_thread_starts.load(), static_cast<size_t>(3));
+    assert_equal(worker_thread_stops.load(), static_cast<size_t>(3));
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -94,6 +185,8 @@ int main() {
     tester.add_step("constructor", test_runtime_constructor);
     tester.add_step("destructor", test_runtime_destructor);
     tester.add_step("version", test_runtime_version);
+    tester.add_step("numa node pools", test_runtime_numa_node_pools);
+    tester.add_step("thread options", test_runtime_thread_options);
 
     tester.launch_test();
     return 0;
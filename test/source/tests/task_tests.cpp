@@ -5,6 +5,7 @@
 #include "utils/object_observer.h"
 
 #include <array>
+#include <thread>
 
 using namespace concurrencpp::tests;
 
@@ -30,6 +31,9 @@ namespace concurrencpp::tests {
     void test_task_assignment_operator_to_self();
     void test_task_assignment_operator();
 
+    void test_task_allocation_pool();
+    void test_task_allocation_pool_coroutine_frames();
+
 }  // namespace concurrencpp::tests
 
 namespace concurrencpp::tests {
@@ -73,6 +77,11 @@ namespace concurrencpp::tests {
 
         static_assert(concurrencpp::details::callable_vtable<inlinable>::is_inlinable(),
                       "callable_vtable<...>::is_inlinable - callable_vtable deduced inlinable functor is *NOT* inlinable.");
+
+        static_assert(concurrencpp::task::is_inlinable<inlinable&>() && !concurrencpp::task::is_inlinable<noexcept_movable_big>(),
+                      "task::is_inlinable - task deduced a wrong inlinability.");
+
+        static_assert(sizeof(concurrencpp::task) == CRCPP_TASK_SIZE, "task - sizeof(task) is different than CRCPP_TASK_SIZE.");
     };
 }  // namespace concurrencpp::tests
 
@@ -652,6 +661,106 @@ void concurrencpp::tests::test_task_assignment_operator() {
     test_task_assignment_operator_to_self();
 }
 
+void concurrencpp::tests::test_task_allocation_pool() {
+    struct big_callable {
+        std::array<char, concurrencpp::details::task_constants::buffer_size + 1> buffer = {};
+        std::shared_ptr<size_t> counter;
+
+        void operator()() {
+            ++(*counter);
+        }
+    };
+
+    static_assert(!task::is_inlinable<big_callable>());
+
+    auto counter = std::make_shared<size_t>(0);
+
+    // storage freed by the allocating thread is reused right away
+    {
+        task first {big_callable {{}, counter}};
+        first();
+
+        const auto before = task::allocation_stats();
+        task second {big_callable {{}, counter}};
+        const auto after = task::allocation_stats();
+
+        assert_equal(after.hit_count, before.hit_count + 1);
+        assert_equal(after.miss_count, before.miss_count);
+
+        second();
+        assert_equal(*counter, static_cast<size_t>(2));
+    }
+
+    // storage freed by another thread goes back to the allocating thread
+    {
+        const size_t task_count = 64;
+        std::vector<task> tasks;
+        for (size_t i = 0; i < task_count; i++) {
+            tasks.emplace_back(big_callable {{}, counter});
+        }
+
+        const auto before = task::allocation_stats();
+
+        std::thread executing_thread([&tasks] {
+            for (auto& task : tasks) {
+                task();
+            }
+        });
+
+        executing_thread.join();
+
+        // the next allocation reclaims the remote frees
+        task reused {big_callable {{}, counter}};
+        const auto after = task::allocation_stats();
+
+        assert_equal(*counter, static_cast<size_t>(2 + task_count));
+        assert_equal(after.remote_free_count, before.remote_free_count + task_count);
+        assert_equal(after.hit_count, before.hit_count + 1);
+    }
+
+    // a task destroyed without being executed frees its storage as well
+    {
+        const auto before = task::allocation_stats();
+        {
+            task destroyed {big_callable {{}, counter}};
+            task cleared {big_callable {{}, counter}};
+            cleared.clear();
+        }
+
+        task reused {big_callable {{}, counter}};
+        const auto after = task::allocation_stats();
+        assert_equal(after.miss_count, before.miss_count);
+    }
+}
+
+namespace concurrencpp::tests {
+    // result coroutines, lazy_result frames might come from the lazy frame stack instead
+    result<int> pooled_frame_coro(int value) {
+        co_return value;
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_task_allocation_pool_coroutine_frames() {
+    const auto before = task::allocation_stats();
+
+    assert_equal(pooled_frame_coro(1).get(), 1);
+    assert_equal(pooled_frame_coro(2).get(), 2);
+    auto result = pooled_frame_coro(3);
+
+    const auto after = task::allocation_stats();
+
+#ifdef CRCPP_COROUTINE_FRAME_CACHE
+    // the first frame might miss, the next ones reuse a freed frame
+    assert_equal(after.hit_count + after.miss_count, before.hit_count + before.miss_count + 3);
+    assert_true(after.hit_count > before.hit_count);
+#else
+    assert_equal(after.hit_count, before.hit_count);
+    assert_equal(after.miss_count, before.miss_count);
+#endif
+
+    assert_equal(result.get(), 3);
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -663,6 +772,8 @@ int main() {
     tester.add_step("operator()", test_task_call_operator);
     tester.add_step("clear", test_task_clear);
     tester.add_step("operator =", test_task_assignment_operator);
+    tester.add_step("allocation pool", test_task_allocation_pool);
+    tester.add_step("allocation pool - coroutine frames", test_task_allocation_pool_coroutine_frames);
 
     tester.launch_test();
     return 0;